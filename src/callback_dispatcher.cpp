@@ -0,0 +1,81 @@
+#include "callback_dispatcher.h"
+#include "utils/LockFreeRing.h"
+#include "utils/logger.h"
+#include <atomic>
+#include <coreinit/event.h>
+#include <coreinit/thread.h>
+
+#define CALLBACK_QUEUE_SIZE        256
+#define CALLBACK_THREAD_STACK_SIZE 0x4000
+#define CALLBACK_THREAD_PRIORITY   30 // 0 is the highest, 31 the lowest priority
+
+typedef struct NotificationCallback {
+    void (*func)(NotificationModuleHandle, void *);
+    NotificationModuleHandle handle;
+    void *context;
+} NotificationCallback;
+
+static LockFreeRing<NotificationCallback, CALLBACK_QUEUE_SIZE> sCallbackQueue;
+static std::atomic<bool> sRunning = false;
+static OSEvent sCallbackEvent;
+alignas(16) static OSThread sCallbackThread;
+alignas(16) static uint8_t sCallbackThreadStack[CALLBACK_THREAD_STACK_SIZE];
+
+static void RunPendingCallbacks() {
+    NotificationCallback callback;
+    while (sCallbackQueue.pop(callback)) {
+        callback.func(callback.handle, callback.context);
+    }
+}
+
+static int CallbackThreadEntry(int argc, const char **argv) {
+    while (sRunning.load(std::memory_order_acquire)) {
+        RunPendingCallbacks();
+        OSWaitEvent(&sCallbackEvent);
+    }
+    RunPendingCallbacks();
+    return 0;
+}
+
+bool StartCallbackDispatcher() {
+    if (sRunning.load(std::memory_order_acquire)) {
+        return true;
+    }
+    OSInitEvent(&sCallbackEvent, FALSE, OS_EVENT_MODE_AUTO);
+    sRunning = true;
+    if (!OSCreateThread(&sCallbackThread,
+                        CallbackThreadEntry,
+                        0,
+                        nullptr,
+                        sCallbackThreadStack + sizeof(sCallbackThreadStack),
+                        sizeof(sCallbackThreadStack),
+                        CALLBACK_THREAD_PRIORITY,
+                        OS_THREAD_ATTRIB_AFFINITY_ANY)) {
+        DEBUG_FUNCTION_LINE_ERR("Failed to create callback thread");
+        sRunning = false;
+        return false;
+    }
+    OSSetThreadName(&sCallbackThread, "NotificationModule callbacks");
+    OSResumeThread(&sCallbackThread);
+    return true;
+}
+
+void StopCallbackDispatcher() {
+    if (sRunning.exchange(false, std::memory_order_acq_rel)) {
+        OSSignalEvent(&sCallbackEvent);
+        OSJoinThread(&sCallbackThread, nullptr);
+    }
+    // Callbacks that have been queued while the thread was shutting down
+    RunPendingCallbacks();
+}
+
+void DispatchNotificationCallback(void (*func)(NotificationModuleHandle, void *), NotificationModuleHandle handle, void *context) {
+    if (func == nullptr) {
+        return;
+    }
+    if (sRunning.load(std::memory_order_acquire) && sCallbackQueue.push({func, handle, context})) {
+        OSSignalEvent(&sCallbackEvent);
+        return;
+    }
+    func(handle, context);
+}
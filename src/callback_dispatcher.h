@@ -0,0 +1,13 @@
+#pragma once
+
+#include <notifications/notification_defines.h>
+
+//!Starts the thread that runs the callbacks of notifications. Called when an application starts.
+bool StartCallbackDispatcher();
+
+//!Stops the dispatcher thread and runs all callbacks that are still pending on the calling thread.
+void StopCallbackDispatcher();
+
+//!Queues a notification callback for the dispatcher thread, so plugin code never runs on the render thread. Lock-free, can be called from any thread.
+//!Runs the callback directly if the dispatcher isn't running or its queue is full.
+void DispatchNotificationCallback(void (*func)(NotificationModuleHandle, void *), NotificationModuleHandle handle, void *context);
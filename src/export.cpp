@@ -1,70 +1,186 @@
+#include "export.h"
 #include "gui/Notification.h"
+#include "notification_commands.h"
 #include "retain_vars.hpp"
+#include "utils/Statistics.h"
 #include "utils/utils.h"
+#include <algorithm>
+#include <coreinit/time.h>
+#include <cstring>
 #include <memory>
 #include <notifications/notifications.h>
+#include <vector>
 #include <wums.h>
 
 void ExportCleanUp() {
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    gNotificationList.clear();
-    std::lock_guard overlay_lock(gOverlayFrameMutex);
-
-    // Remove notification in queue that should not survive
-    std::vector<std::shared_ptr<Notification>> keepQueue;
-    for (const auto &notification : gOverlayQueueDuringStartup) {
-        if (notification->isKeepUntilShown()) {
-            keepQueue.push_back(notification);
-        } else {
-        }
-    }
-    gOverlayQueueDuringStartup.clear();
-    gOverlayQueueDuringStartup = keepQueue;
+    CleanUpNotificationCommands();
 }
 
-NotificationModuleStatus NMAddStaticNotificationV2(const char *text,
-                                                   NotificationModuleNotificationType type,
-                                                   float durationBeforeFadeOutInSeconds,
-                                                   float shakeDurationInSeconds,
-                                                   NMColor textColor,
-                                                   NMColor backgroundColor,
-                                                   void (*finishFunc)(NotificationModuleHandle, void *context),
-                                                   void *context,
-                                                   bool keepUntilShown) {
+static inline GX2Color ToGX2Color(NMColor color) {
+    return (GX2Color){color.r, color.g, color.b, color.a};
+}
 
+void NMNotificationRemovedFromOverlay(Notification *notification) {
+    if (notification) {
+        // Called by the render thread which owns the table entries of added notifications.
+        ReleaseNotificationHandle(notification->getHandle());
+    }
+}
+
+//! Creates a fully configured notification (and reserves a handle for dynamic notifications), the command still has to be queued.
+static NotificationModuleStatus PrepareNotification(NotificationCommand &outCommand, const NMNotificationDescV3 &desc) {
     NotificationStatus status;
-    switch (type) {
+    bool dynamic = false;
+    switch (desc.type) {
         case NOTIFICATION_MODULE_NOTIFICATION_TYPE_INFO:
             status = NOTIFICATION_STATUS_INFO;
             break;
         case NOTIFICATION_MODULE_NOTIFICATION_TYPE_ERROR:
             status = NOTIFICATION_STATUS_ERROR;
             break;
+        case NOTIFICATION_MODULE_NOTIFICATION_TYPE_DYNAMIC:
+            status  = NOTIFICATION_STATUS_IN_PROGRESS;
+            dynamic = true;
+            break;
         default:
             return NOTIFICATION_MODULE_RESULT_UNSUPPORTED_TYPE;
     }
-    auto notification = make_shared_nothrow<Notification>(
-            text,
+    // Checked before anything is allocated or reserved
+    if (desc.stack >= NM_NOTIFICATION_STACK_COUNT || (desc.flags & ~NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN) != 0) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    if (desc.fontSize != 0 && (desc.fontSize < NM_NOTIFICATION_MIN_FONT_SIZE || desc.fontSize > NM_NOTIFICATION_MAX_FONT_SIZE)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    auto notification = make_shared_pooled<Notification, gNotificationPool>(
+            desc.text != nullptr ? desc.text : "",
             status,
-            durationBeforeFadeOutInSeconds,
-            shakeDurationInSeconds,
-            (GX2Color){textColor.r, textColor.g, textColor.b, textColor.a},
-            (GX2Color){backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a},
-            finishFunc,
-            context,
-            nullptr,
-            keepUntilShown);
+            dynamic ? 0.0f : desc.durationBeforeFadeOutInSeconds,
+            dynamic ? 0.0f : desc.shakeDurationInSeconds,
+            ToGX2Color(desc.textColor),
+            ToGX2Color(desc.backgroundColor),
+            desc.finishFunc,
+            desc.context,
+            dynamic ? NMNotificationRemovedFromOverlay : nullptr,
+            (desc.flags & NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN) != 0);
     if (!notification) {
         return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
     }
+    if (desc.fontSize != 0) {
+        notification->updateFontSize((int32_t) desc.fontSize);
+    }
+    notification->setShownCallback(desc.shownFunc);
+    notification->setStack((OverlayStackId) desc.stack);
 
-    {
-        std::lock_guard lock(gOverlayFrameMutex);
-        if (gOverlayFrame && gDrawReady) {
-            gOverlayFrame->addNotification(std::move(notification));
-        } else {
-            gOverlayQueueDuringStartup.push_back(std::move(notification));
+    uint32_t handle = 0;
+    if (dynamic) {
+        handle = ReserveNotificationHandle();
+        if (handle == 0) {
+            notification->cancelCallbacks();
+            return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
         }
+        notification->setHandle(handle);
+    }
+
+    outCommand.type         = NOTIFICATION_COMMAND_ADD;
+    outCommand.handle       = handle;
+    outCommand.notification = std::move(notification);
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+//! Reverts Prepare*Notification for a command that couldn't be queued
+static void DiscardPreparedNotification(NotificationCommand &command) {
+    if (command.notification) {
+        // The caller gets an error and cleans up the context itself, the notification has never existed for it.
+        command.notification->cancelCallbacks();
+    }
+    if (command.handle != 0) {
+        // The render thread doesn't know about the handle yet, so we still own it.
+        gNotificationHandleTable.release(command.handle);
+        command.handle = 0;
+    }
+    command.notification.reset();
+}
+
+static NotificationModuleStatus PrepareFinishCommand(NotificationCommand &outCommand,
+                                                     NotificationModuleHandle handle,
+                                                     NotificationModuleStatusFinish finishMode,
+                                                     float durationBeforeFadeOutInSeconds,
+                                                     float shakeDurationInSeconds) {
+    NotificationStatus newStatus;
+    switch (finishMode) {
+        case NOTIFICATION_MODULE_STATUS_FINISH:
+            newStatus = NOTIFICATION_STATUS_INFO;
+            break;
+        case NOTIFICATION_MODULE_STATUS_FINISH_WITH_SHAKE:
+            newStatus = NOTIFICATION_STATUS_ERROR;
+            break;
+        default:
+            return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (!gNotificationHandleTable.isValid(handle)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
+    }
+    outCommand.type          = NOTIFICATION_COMMAND_FINISH;
+    outCommand.handle        = handle;
+    outCommand.status        = newStatus;
+    outCommand.waitDuration  = durationBeforeFadeOutInSeconds;
+    outCommand.shakeDuration = shakeDurationInSeconds;
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+//! The handle may have been released while the update was queued
+static NotificationModuleStatus QueueFailureStatus(NotificationModuleHandle handle) {
+    return gNotificationHandleTable.isValid(handle) ? NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED : NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
+}
+
+static NotificationModuleStatus QueueTextUpdate(NotificationModuleHandle handle, const char *text) {
+    // Only the latest text is applied at the next frame, superseded ones are never converted or measured.
+    auto *copy = strdup(text != nullptr ? text : "");
+    if (copy == nullptr) {
+        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
+    }
+    if (!QueueNotificationTextUpdate(handle, copy)) {
+        return QueueFailureStatus(handle);
+    }
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+NotificationModuleStatus NMAddStaticNotificationV2(const char *text,
+                                                   NotificationModuleNotificationType type,
+                                                   float durationBeforeFadeOutInSeconds,
+                                                   float shakeDurationInSeconds,
+                                                   NMColor textColor,
+                                                   NMColor backgroundColor,
+                                                   void (*finishFunc)(NotificationModuleHandle, void *context),
+                                                   void *context,
+                                                   bool keepUntilShown) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+
+    if (type == NOTIFICATION_MODULE_NOTIFICATION_TYPE_DYNAMIC) {
+        return NOTIFICATION_MODULE_RESULT_UNSUPPORTED_TYPE;
+    }
+    NMNotificationDescV3 desc           = {};
+    desc.size                           = sizeof(desc);
+    desc.text                           = text;
+    desc.type                           = type;
+    desc.flags                          = keepUntilShown ? NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN : 0;
+    desc.durationBeforeFadeOutInSeconds = durationBeforeFadeOutInSeconds;
+    desc.shakeDurationInSeconds         = shakeDurationInSeconds;
+    desc.textColor                      = textColor;
+    desc.backgroundColor                = backgroundColor;
+    desc.finishFunc                     = finishFunc;
+    desc.context                        = context;
+
+    NotificationCommand command;
+    auto res = PrepareNotification(command, desc);
+    if (res != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+        return res;
+    }
+    if (PushNotificationCommands(&command, 1) != 1) {
+        DiscardPreparedNotification(command);
+        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
     }
 
     return NOTIFICATION_MODULE_RESULT_SUCCESS;
@@ -82,15 +198,6 @@ NotificationModuleStatus NMAddStaticNotification(const char *text,
     return NMAddStaticNotificationV2(text, type, durationBeforeFadeOutInSeconds, shakeDurationInSeconds, textColor, backgroundColor, finishFunc, context, false);
 }
 
-void NMNotificationRemovedFromOverlay(Notification *notification) {
-    if (notification) {
-        auto handle = notification->getHandle();
-        if (!remove_locked_first_if(gNotificationListMutex, gNotificationList, [handle](auto &cur) { return cur->getHandle() == handle; })) {
-            DEBUG_FUNCTION_LINE_ERR("NMNotificationRemovedFromOverlay failed");
-        }
-    }
-}
-
 NotificationModuleStatus NMAddDynamicNotificationV2(const char *text,
                                                     NMColor textColor,
                                                     NMColor backgroundColor,
@@ -98,39 +205,33 @@ NotificationModuleStatus NMAddDynamicNotificationV2(const char *text,
                                                     void *context,
                                                     bool keep_until_shown,
                                                     NotificationModuleHandle *outHandle) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
     if (outHandle == nullptr) {
         return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
     }
     *outHandle = 0;
 
-    auto notification = make_shared_nothrow<Notification>(
-            text,
-            NOTIFICATION_STATUS_IN_PROGRESS,
-            0.0f,
-            0.0f,
-            (GX2Color){textColor.r, textColor.g, textColor.b, textColor.a},
-            (GX2Color){backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a},
-            finishFunc,
-            context,
-            NMNotificationRemovedFromOverlay,
-            keep_until_shown);
-    if (!notification) {
-        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
-    }
+    NMNotificationDescV3 desc = {};
+    desc.size                 = sizeof(desc);
+    desc.text                 = text;
+    desc.type                 = NOTIFICATION_MODULE_NOTIFICATION_TYPE_DYNAMIC;
+    desc.flags                = keep_until_shown ? NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN : 0;
+    desc.textColor            = textColor;
+    desc.backgroundColor      = backgroundColor;
+    desc.finishFunc           = finishFunc;
+    desc.context              = context;
 
-    {
-        std::lock_guard<std::mutex> lock(gNotificationListMutex);
-        *outHandle = notification->getHandle();
-        {
-            std::lock_guard overlay_lock(gOverlayFrameMutex);
-            if (gOverlayFrame) {
-                gOverlayFrame->addNotification(notification);
-            } else {
-                gOverlayQueueDuringStartup.push_back(notification);
-            }
-        }
-        gNotificationList.push_front(std::move(notification));
+    NotificationCommand command;
+    auto res = PrepareNotification(command, desc);
+    if (res != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+        return res;
+    }
+    auto handle = command.handle;
+    if (PushNotificationCommands(&command, 1) != 1) {
+        DiscardPreparedNotification(command);
+        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
     }
+    *outHandle = handle;
 
     return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
@@ -144,76 +245,223 @@ NotificationModuleStatus NMAddDynamicNotification(const char *text,
     return NMAddDynamicNotificationV2(text, textColor, backgroundColor, finishFunc, context, false, outHandle);
 }
 
+NotificationModuleStatus NMAddNotificationV3(const NMNotificationDescV3 *desc, NotificationModuleHandle *outHandle) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (desc == nullptr || desc->size < NM_NOTIFICATION_DESC_V3_MIN_SIZE) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    if (outHandle != nullptr) {
+        *outHandle = 0;
+    }
+    if (desc->type == NOTIFICATION_MODULE_NOTIFICATION_TYPE_DYNAMIC && outHandle == nullptr) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+
+    // Callers built against an older header pass a smaller struct, the missing fields keep their defaults.
+    NMNotificationDescV3 fullDesc = {};
+    memcpy(&fullDesc, desc, std::min<uint32_t>(desc->size, sizeof(fullDesc)));
+
+    NotificationCommand command;
+    auto res = PrepareNotification(command, fullDesc);
+    if (res != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+        return res;
+    }
+    auto handle = command.handle;
+    if (PushNotificationCommands(&command, 1) != 1) {
+        DiscardPreparedNotification(command);
+        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
+    }
+    if (outHandle != nullptr) {
+        *outHandle = handle;
+    }
+
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+NotificationModuleStatus NMAddNotificationsBatch(const NMNotificationBatchEntry *entries,
+                                                 uint32_t count,
+                                                 NotificationModuleHandle *outHandles,
+                                                 NotificationModuleStatus *outStatus) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (entries == nullptr || outStatus == nullptr || count == 0) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+
+    std::vector<NotificationCommand> commands;
+    std::vector<uint32_t> commandEntries;
+    commands.reserve(count);
+    commandEntries.reserve(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const auto &entry                   = entries[i];
+        NMNotificationDescV3 desc           = {};
+        desc.size                           = sizeof(desc);
+        desc.text                           = entry.text;
+        desc.type                           = entry.type;
+        desc.flags                          = entry.keepUntilShown ? NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN : 0;
+        desc.durationBeforeFadeOutInSeconds = entry.durationBeforeFadeOutInSeconds;
+        desc.shakeDurationInSeconds         = entry.shakeDurationInSeconds;
+        desc.textColor                      = entry.textColor;
+        desc.backgroundColor                = entry.backgroundColor;
+        desc.finishFunc                     = entry.finishFunc;
+        desc.context                        = entry.context;
+
+        NotificationCommand command;
+        if (entry.type == NOTIFICATION_MODULE_NOTIFICATION_TYPE_DYNAMIC && outHandles == nullptr) {
+            outStatus[i] = NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+        } else {
+            outStatus[i] = PrepareNotification(command, desc);
+        }
+        if (outHandles != nullptr) {
+            outHandles[i] = command.handle;
+        }
+        if (outStatus[i] == NOTIFICATION_MODULE_RESULT_SUCCESS) {
+            commands.push_back(std::move(command));
+            commandEntries.push_back(i);
+        }
+    }
+
+    // Publish everything at once, the render thread picks it up at the next frame.
+    uint32_t pushed = PushNotificationCommands(commands.data(), commands.size());
+    for (uint32_t j = pushed; j < commands.size(); j++) {
+        uint32_t i = commandEntries[j];
+        DiscardPreparedNotification(commands[j]);
+        outStatus[i] = NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
+        if (outHandles != nullptr) {
+            outHandles[i] = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (outStatus[i] != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+            return outStatus[i];
+        }
+    }
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
 NotificationModuleStatus NMUpdateDynamicNotificationText(NotificationModuleHandle handle,
                                                          const char *text) {
-    NotificationModuleStatus res = NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    for (auto &cur : gNotificationList) {
-        if (cur->getHandle() == handle) {
-            cur->updateText(text);
-            res = NOTIFICATION_MODULE_RESULT_SUCCESS;
-            break;
-        }
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (!gNotificationHandleTable.isValid(handle)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
     }
-    return res;
+    return QueueTextUpdate(handle, text);
 }
 
 NotificationModuleStatus NMUpdateDynamicNotificationBackgroundColor(NotificationModuleHandle handle,
                                                                     NMColor backgroundColor) {
-    NotificationModuleStatus res = NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    for (auto &cur : gNotificationList) {
-        if (cur->getHandle() == handle) {
-            cur->updateBackgroundColor((GX2Color){backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a});
-            res = NOTIFICATION_MODULE_RESULT_SUCCESS;
-            break;
-        }
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (!gNotificationHandleTable.isValid(handle)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
+    }
+    if (!QueueNotificationBackgroundColorUpdate(handle, ToGX2Color(backgroundColor))) {
+        return QueueFailureStatus(handle);
     }
-    return res;
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
 
 NotificationModuleStatus NMUpdateDynamicNotificationTextColor(NotificationModuleHandle handle,
                                                               NMColor textColor) {
-    NotificationModuleStatus res = NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    for (auto &cur : gNotificationList) {
-        if (cur->getHandle() == handle) {
-            cur->updateTextColor((GX2Color){textColor.r, textColor.g, textColor.b, textColor.a});
-            res = NOTIFICATION_MODULE_RESULT_SUCCESS;
-            break;
-        }
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (!gNotificationHandleTable.isValid(handle)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
     }
-    return res;
+    if (!QueueNotificationTextColorUpdate(handle, ToGX2Color(textColor))) {
+        return QueueFailureStatus(handle);
+    }
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
 
 NotificationModuleStatus NMFinishDynamicNotification(NotificationModuleHandle handle,
                                                      NotificationModuleStatusFinish finishMode,
                                                      float durationBeforeFadeOutInSeconds,
                                                      float shakeDurationInSeconds) {
-    NotificationStatus newStatus;
-    switch (finishMode) {
-        case NOTIFICATION_MODULE_STATUS_FINISH:
-            newStatus = NOTIFICATION_STATUS_INFO;
-            break;
-        case NOTIFICATION_MODULE_STATUS_FINISH_WITH_SHAKE:
-            newStatus = NOTIFICATION_STATUS_ERROR;
-            break;
-        default:
-            return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    NotificationCommand command;
+    auto res = PrepareFinishCommand(command, handle, finishMode, durationBeforeFadeOutInSeconds, shakeDurationInSeconds);
+    if (res != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+        return res;
+    }
+    if (!PushNotificationCommand(command)) {
+        return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
     }
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
 
-    NotificationModuleStatus res = NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    for (auto &cur : gNotificationList) {
-        if (cur->getHandle() == handle) {
-            cur->updateStatus(newStatus);
-            cur->updateWaitDuration(durationBeforeFadeOutInSeconds);
-            cur->updateShakeDuration(shakeDurationInSeconds);
-            res = NOTIFICATION_MODULE_RESULT_SUCCESS;
-            break;
+static NotificationModuleStatus QueueBatchUpdate(const NMNotificationUpdateBatchEntry &entry, NotificationCommand &outFinishCommand, bool &outFinish) {
+    outFinish = false;
+    // Everything that can be checked is validated before the first value is queued, so a rejected entry leaves the notification untouched.
+    if (!gNotificationHandleTable.isValid(entry.handle)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_HANDLE;
+    }
+    if (entry.flags & ~(NM_UPDATE_TEXT | NM_UPDATE_TEXT_COLOR | NM_UPDATE_BACKGROUND_COLOR | NM_UPDATE_FINISH)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    if (entry.flags & NM_UPDATE_FINISH) {
+        auto res = PrepareFinishCommand(outFinishCommand, entry.handle, entry.finishMode, entry.durationBeforeFadeOutInSeconds, entry.shakeDurationInSeconds);
+        if (res != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+            return res;
+        }
+    }
+    char *text = nullptr;
+    if (entry.flags & NM_UPDATE_TEXT) {
+        text = strdup(entry.text != nullptr ? entry.text : "");
+        if (text == nullptr) {
+            return NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
+        }
+    }
+
+    if (text != nullptr && !QueueNotificationTextUpdate(entry.handle, text)) {
+        return QueueFailureStatus(entry.handle);
+    }
+    if ((entry.flags & NM_UPDATE_TEXT_COLOR) && !QueueNotificationTextColorUpdate(entry.handle, ToGX2Color(entry.textColor))) {
+        return QueueFailureStatus(entry.handle);
+    }
+    if ((entry.flags & NM_UPDATE_BACKGROUND_COLOR) && !QueueNotificationBackgroundColorUpdate(entry.handle, ToGX2Color(entry.backgroundColor))) {
+        return QueueFailureStatus(entry.handle);
+    }
+    outFinish = (entry.flags & NM_UPDATE_FINISH) != 0;
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+NotificationModuleStatus NMUpdateDynamicNotificationsBatch(const NMNotificationUpdateBatchEntry *entries,
+                                                           uint32_t count,
+                                                           NotificationModuleStatus *outStatus) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_API_CALL);
+    if (entries == nullptr || outStatus == nullptr || count == 0) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+
+    std::vector<NotificationCommand> finishCommands;
+    std::vector<uint32_t> finishEntries;
+
+    for (uint32_t i = 0; i < count; i++) {
+        NotificationCommand command;
+        bool finish;
+        outStatus[i] = QueueBatchUpdate(entries[i], command, finish);
+        if (finish) {
+            if (finishCommands.empty()) {
+                finishCommands.reserve(count - i);
+                finishEntries.reserve(count - i);
+            }
+            finishCommands.push_back(std::move(command));
+            finishEntries.push_back(i);
+        }
+    }
+
+    // Queued after the pending updates of the same batch, so the latest text is visible when finishing.
+    uint32_t pushed = PushNotificationCommands(finishCommands.data(), finishCommands.size());
+    for (uint32_t j = pushed; j < finishCommands.size(); j++) {
+        outStatus[finishEntries[j]] = NOTIFICATION_MODULE_RESULT_ALLOCATION_FAILED;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (outStatus[i] != NOTIFICATION_MODULE_RESULT_SUCCESS) {
+            return outStatus[i];
         }
     }
-    return res;
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
 
 NotificationModuleStatus NMIsOverlayReady(bool *outIsReady) {
@@ -228,14 +476,106 @@ NotificationModuleStatus NMIsOverlayReady(bool *outIsReady) {
     return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
 
+NotificationModuleStatus NMWaitOverlayReady(uint32_t timeoutInMs) {
+    if (gDrawReady) {
+        return NOTIFICATION_MODULE_RESULT_SUCCESS;
+    }
+    if (timeoutInMs == NM_WAIT_INFINITE) {
+        OSWaitEvent(&gOverlayReadyEvent);
+        return NOTIFICATION_MODULE_RESULT_SUCCESS;
+    }
+    // OSWaitEventWithTimeout expects the timeout in nanoseconds, not in ticks
+    if (timeoutInMs == 0 || !OSWaitEventWithTimeout(&gOverlayReadyEvent, (uint64_t) timeoutInMs * 1000000ULL)) {
+        return NOTIFICATION_MODULE_RESULT_OVERLAY_NOT_READY;
+    }
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+static_assert(NM_OVERFLOW_POLICY_QUEUE == (int) OVERLAY_OVERFLOW_POLICY_QUEUE &&
+                      NM_OVERFLOW_POLICY_DROP_OLDEST == (int) OVERLAY_OVERFLOW_POLICY_DROP_OLDEST &&
+                      NM_OVERFLOW_POLICY_DROP_LOWEST == (int) OVERLAY_OVERFLOW_POLICY_DROP_LOWEST,
+              "Overflow policies differ");
+
+NotificationModuleStatus NMSetOverlayLimits(uint32_t maxVisible, NMOverflowPolicy policy) {
+    if (maxVisible == 0 || policy > NM_OVERFLOW_POLICY_DROP_LOWEST) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    for (auto &limit : gOverlayMaxVisible) {
+        limit.store(maxVisible, std::memory_order_relaxed);
+    }
+    gOverlayOverflowPolicy.store(policy, std::memory_order_relaxed);
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+static_assert(NM_NOTIFICATION_STACK_TOP_LEFT == (int) OVERLAY_STACK_TOP_LEFT &&
+                      NM_NOTIFICATION_STACK_TOP_RIGHT == (int) OVERLAY_STACK_TOP_RIGHT &&
+                      NM_NOTIFICATION_STACK_BOTTOM_LEFT == (int) OVERLAY_STACK_BOTTOM_LEFT &&
+                      NM_NOTIFICATION_STACK_BOTTOM_RIGHT == (int) OVERLAY_STACK_BOTTOM_RIGHT &&
+                      NM_NOTIFICATION_STACK_TOP_CENTER == (int) OVERLAY_STACK_TOP_CENTER &&
+                      NM_NOTIFICATION_STACK_PROGRESS == (int) OVERLAY_STACK_PROGRESS &&
+                      NM_NOTIFICATION_STACK_COUNT == (int) OVERLAY_STACK_COUNT,
+              "Notification stacks differ");
+
+NotificationModuleStatus NMSetStackLimit(NMNotificationStack stack, uint32_t maxVisible) {
+    if (maxVisible == 0 || stack >= NM_NOTIFICATION_STACK_COUNT) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    gOverlayMaxVisible[stack].store(maxVisible, std::memory_order_relaxed);
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+static void FillOverlayGPUTiming(GPUTimer &timer, NMOverlayGPUTiming *out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->sampleCount = timer.getStats(out->minInNs, out->avgInNs, out->p99InNs, out->lastInNs);
+}
+
+NotificationModuleStatus NMGetOverlayGPUTiming(NMOverlayGPUTiming *outTV, NMOverlayGPUTiming *outDRC) {
+    if (outTV == nullptr && outDRC == nullptr) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    FillOverlayGPUTiming(gTVOverlayGPUTimer, outTV);
+    FillOverlayGPUTiming(gDRCOverlayGPUTimer, outDRC);
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
+static_assert(NM_STATISTICS_HISTOGRAM_BUCKETS == STATISTIC_HISTOGRAM_BUCKETS, "Histogram layouts differ");
+
+static void FillTimingHistogram(StatisticTimer timer, NMTimingHistogram *out) {
+    const auto &histogram = StatisticsGetHistogram(timer);
+    out->count            = histogram.count.load(std::memory_order_relaxed);
+    out->maxInUs          = histogram.maxInUs.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < NM_STATISTICS_HISTOGRAM_BUCKETS; i++) {
+        out->buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+NotificationModuleStatus NMGetStatistics(NMStatistics *outStatistics) {
+    if (outStatistics == nullptr || outStatistics->size < sizeof(NMStatistics)) {
+        return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
+    }
+    FillTimingHistogram(STATISTIC_TIMER_FRAME_PROCESS, &outStatistics->frameProcess);
+    FillTimingHistogram(STATISTIC_TIMER_OVERLAY_DRAW, &outStatistics->overlayDraw);
+    FillTimingHistogram(STATISTIC_TIMER_CACHE_GLYPH, &outStatistics->glyphCache);
+    FillTimingHistogram(STATISTIC_TIMER_API_CALL, &outStatistics->apiCalls);
+    StatisticsGetGlyphCacheLookups(outStatistics->glyphCacheHits, outStatistics->glyphCacheMisses);
+    outStatistics->queueDepth           = GetPendingNotificationCommandCount();
+    outStatistics->liveNotifications    = StatisticsGetLiveNotificationCount();
+    outStatistics->supersededUpdates    = StatisticsGetSupersededUpdateCount();
+    outStatistics->droppedNotifications = StatisticsGetDroppedNotificationCount();
+    return NOTIFICATION_MODULE_RESULT_SUCCESS;
+}
+
 NotificationModuleStatus NMGetVersion(NotificationModuleAPIVersion *outVersion) {
     if (outVersion == nullptr) {
         return NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT;
     }
-    *outVersion = 2;
+    *outVersion = 3;
     return NOTIFICATION_MODULE_RESULT_SUCCESS;
 }
 
+WUMS_EXPORT_FUNCTION(NMAddNotificationV3);
 WUMS_EXPORT_FUNCTION(NMAddDynamicNotificationV2);
 WUMS_EXPORT_FUNCTION(NMAddStaticNotificationV2);
 WUMS_EXPORT_FUNCTION(NMAddDynamicNotification);
@@ -245,4 +585,11 @@ WUMS_EXPORT_FUNCTION(NMUpdateDynamicNotificationBackgroundColor);
 WUMS_EXPORT_FUNCTION(NMUpdateDynamicNotificationTextColor);
 WUMS_EXPORT_FUNCTION(NMFinishDynamicNotification);
 WUMS_EXPORT_FUNCTION(NMIsOverlayReady);
+WUMS_EXPORT_FUNCTION(NMWaitOverlayReady);
+WUMS_EXPORT_FUNCTION(NMSetOverlayLimits);
+WUMS_EXPORT_FUNCTION(NMSetStackLimit);
 WUMS_EXPORT_FUNCTION(NMGetVersion);
+WUMS_EXPORT_FUNCTION(NMGetOverlayGPUTiming);
+WUMS_EXPORT_FUNCTION(NMGetStatistics);
+WUMS_EXPORT_FUNCTION(NMAddNotificationsBatch);
+WUMS_EXPORT_FUNCTION(NMUpdateDynamicNotificationsBatch);
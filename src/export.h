@@ -1,3 +1,153 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <notifications/notification_defines.h>
+
+//! GPU time spent on the overlay pass of one scan target, over the last few frames
+typedef struct NMOverlayGPUTiming {
+    uint32_t sampleCount; //!< Number of frames the values are based on, 0 if nothing has been measured yet
+    uint32_t lastInNs;
+    uint32_t minInNs;
+    uint32_t avgInNs;
+    uint32_t p99InNs;
+} NMOverlayGPUTiming;
+
+NotificationModuleStatus NMGetOverlayGPUTiming(NMOverlayGPUTiming *outTV, NMOverlayGPUTiming *outDRC);
+
+//! Bucket 0 counts durations < 1us, bucket n counts [2^(n-1), 2^n) us, the last bucket is open-ended
+#define NM_STATISTICS_HISTOGRAM_BUCKETS 16
+
+typedef struct NMTimingHistogram {
+    uint32_t count;
+    uint32_t maxInUs;
+    uint32_t buckets[NM_STATISTICS_HISTOGRAM_BUCKETS];
+} NMTimingHistogram;
+
+typedef struct NMStatistics {
+    uint32_t size;                  //!< Has to be set to sizeof(NMStatistics) by the caller
+    NMTimingHistogram frameProcess; //!< Per frame update of the overlay in GX2SwapScanBuffers
+    NMTimingHistogram overlayDraw;  //!< Drawing the overlay into a color buffer
+    NMTimingHistogram glyphCache;   //!< Glyph cache lookups, including rendering of missing glyphs
+    NMTimingHistogram apiCalls;     //!< Calls to the exported NM* functions
+    uint32_t glyphCacheHits;
+    uint32_t glyphCacheMisses;
+    uint32_t queueDepth;           //!< API requests waiting to be applied by the render thread
+    uint32_t liveNotifications;    //!< Notifications that currently exist
+    uint32_t supersededUpdates;    //!< Dynamic notification updates that were replaced before being applied
+    uint32_t droppedNotifications; //!< Notifications that have been removed by the overflow policy, see NMSetOverlayLimits
+} NMStatistics;
+
+NotificationModuleStatus NMGetStatistics(NMStatistics *outStatistics);
+
+typedef struct NMNotificationBatchEntry {
+    const char *text;
+    NotificationModuleNotificationType type; //!< INFO or ERROR adds a static notification, DYNAMIC a dynamic one
+    float durationBeforeFadeOutInSeconds;    //!< Ignored for dynamic notifications
+    float shakeDurationInSeconds;            //!< Ignored for dynamic notifications
+    NMColor textColor;
+    NMColor backgroundColor;
+    NotificationModuleNotificationFinishedCallback finishFunc;
+    void *context;
+    bool keepUntilShown;
+} NMNotificationBatchEntry;
+
+//! Adds count notifications at once.
+//! outStatus[i] receives the result of entries[i], outHandles[i] the handle of a dynamic notification (0 otherwise).
+//! outHandles may only be nullptr if there are no dynamic entries.
+//! \return NOTIFICATION_MODULE_RESULT_SUCCESS if all entries have been added, otherwise the first failed status
+NotificationModuleStatus NMAddNotificationsBatch(const NMNotificationBatchEntry *entries,
+                                                 uint32_t count,
+                                                 NotificationModuleHandle *outHandles,
+                                                 NotificationModuleStatus *outStatus);
+
+typedef enum NMNotificationUpdateFlags {
+    NM_UPDATE_TEXT             = 1 << 0,
+    NM_UPDATE_TEXT_COLOR       = 1 << 1,
+    NM_UPDATE_BACKGROUND_COLOR = 1 << 2,
+    NM_UPDATE_FINISH           = 1 << 3, //!< Applied after the other updates of the entry
+} NMNotificationUpdateFlags;
+
+typedef struct NMNotificationUpdateBatchEntry {
+    NotificationModuleHandle handle;
+    uint32_t flags; //!< NMNotificationUpdateFlags, selects which of the fields below are used
+    const char *text;
+    NMColor textColor;
+    NMColor backgroundColor;
+    NotificationModuleStatusFinish finishMode;
+    float durationBeforeFadeOutInSeconds;
+    float shakeDurationInSeconds;
+} NMNotificationUpdateBatchEntry;
+
+//! Updates count dynamic notifications at once, outStatus[i] receives the result of entries[i].
+//! An entry with an invalid handle, flag or finish mode is rejected as a whole. If the command queue runs full while an entry
+//! is queued, the values queued before stay pending and are applied with the next successful update of that notification.
+//! \return NOTIFICATION_MODULE_RESULT_SUCCESS if all entries have been updated, otherwise the first failed status
+NotificationModuleStatus NMUpdateDynamicNotificationsBatch(const NMNotificationUpdateBatchEntry *entries,
+                                                           uint32_t count,
+                                                           NotificationModuleStatus *outStatus);
+
+typedef enum NMNotificationStack {
+    NM_NOTIFICATION_STACK_TOP_LEFT     = 0, //!< Default
+    NM_NOTIFICATION_STACK_TOP_RIGHT    = 1,
+    NM_NOTIFICATION_STACK_BOTTOM_LEFT  = 2,
+    NM_NOTIFICATION_STACK_BOTTOM_RIGHT = 3,
+    NM_NOTIFICATION_STACK_TOP_CENTER   = 4,
+    NM_NOTIFICATION_STACK_PROGRESS     = 5, //!< Bottom center, meant for dynamic notifications that report a progress
+    NM_NOTIFICATION_STACK_COUNT        = 6,
+} NMNotificationStack;
+
+typedef enum NMNotificationFlags {
+    NM_NOTIFICATION_FLAG_KEEP_UNTIL_SHOWN = 1 << 0, //!< Keep the notification queued across application switches until it has been shown
+} NMNotificationFlags;
+
+//! Full configuration of a notification. New fields are only ever appended, older callers pass a smaller size and get the defaults.
+typedef struct NMNotificationDescV3 {
+    uint32_t size; //!< Has to be set to sizeof(NMNotificationDescV3) by the caller
+    const char *text;
+    NotificationModuleNotificationType type; //!< INFO or ERROR adds a static notification, DYNAMIC a dynamic one
+    uint32_t flags;                          //!< NMNotificationFlags
+    float durationBeforeFadeOutInSeconds;    //!< Ignored for dynamic notifications
+    float shakeDurationInSeconds;            //!< Ignored for dynamic notifications
+    NMColor textColor;
+    NMColor backgroundColor;
+    uint32_t fontSize; //!< 0 to use the default size, otherwise NM_NOTIFICATION_MIN_FONT_SIZE - NM_NOTIFICATION_MAX_FONT_SIZE
+    NotificationModuleNotificationFinishedCallback finishFunc;
+    void *context;
+    NotificationModuleNotificationFinishedCallback shownFunc; //!< Called with context once the notification has been drawn for the first time
+    NMNotificationStack stack;                                //!< Anchor the notification is shown at, every stack is laid out independently
+} NMNotificationDescV3;
+
+#define NM_NOTIFICATION_MIN_FONT_SIZE    8
+#define NM_NOTIFICATION_MAX_FONT_SIZE    128
+
+#define NM_NOTIFICATION_DESC_V3_MIN_SIZE (offsetof(NMNotificationDescV3, context) + sizeof(void *))
+
+//! Adds a fully configured notification with a single call.
+//! Unknown flags or a font size out of range are rejected with NOTIFICATION_MODULE_RESULT_INVALID_ARGUMENT.
+//! \param outHandle receives the handle of a dynamic notification, may be nullptr for static notifications
+NotificationModuleStatus NMAddNotificationV3(const NMNotificationDescV3 *desc, NotificationModuleHandle *outHandle);
+
+typedef enum NMOverflowPolicy {
+    NM_OVERFLOW_POLICY_QUEUE       = 0, //!< Wait until a visible notification has been removed, higher priorities first
+    NM_OVERFLOW_POLICY_DROP_OLDEST = 1, //!< Remove the oldest visible notification
+    NM_OVERFLOW_POLICY_DROP_LOWEST = 2, //!< Remove the oldest visible notification with the lowest priority, or drop the new one if its priority is even lower
+} NMOverflowPolicy;
+
+//! Limits the number of visible notifications, the priority is derived from the type: error > info > dynamic (in progress).
+//! The policy is global, maxVisible is applied to every stack. The limits apply to notifications that are added afterwards.
+//! \param maxVisible has to be at least 1, the default is 16
+NotificationModuleStatus NMSetOverlayLimits(uint32_t maxVisible, NMOverflowPolicy policy);
+
+//! Limits the number of visible notifications of a single stack, see NMSetOverlayLimits.
+//! \param maxVisible has to be at least 1, the default is 16
+NotificationModuleStatus NMSetStackLimit(NMNotificationStack stack, uint32_t maxVisible);
+
+#define NM_WAIT_INFINITE 0xFFFFFFFF
+
+//! Blocks until notifications are drawn in the current application, must not be called from the render thread.
+//! \param timeoutInMs 0 to only check the state, NM_WAIT_INFINITE to wait without a timeout
+//! \return NOTIFICATION_MODULE_RESULT_OVERLAY_NOT_READY on timeout
+NotificationModuleStatus NMWaitOverlayReady(uint32_t timeoutInMs);
+
 void ExportCleanUp();
\ No newline at end of file
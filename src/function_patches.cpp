@@ -1,6 +1,8 @@
+#include "notification_commands.h"
 #include "retain_vars.hpp"
 #include "shaders/ColorShader.h"
 #include "shaders/Texture2DShader.h"
+#include "utils/Statistics.h"
 #include <function_patcher/fpatching_defines.h>
 #include <gx2/state.h>
 
@@ -8,12 +10,64 @@ bool drawScreenshotSavedTexture(const GX2ColorBuffer *colorBuffer, GX2ScanTarget
 
 GX2ColorBuffer lastTVColorBuffer;
 GX2ColorBuffer lastDRCColorBuffer;
+bool lastTVColorBufferValid  = false;
+bool lastDRCColorBufferValid = false;
+
+// Per scan target state that is only recomputed if the target buffer changes.
+typedef struct OverlayTargetState {
+    GX2ColorBuffer colorBuffer; //!< Re-initialized copy of the buffer passed to GX2CopyColorBufferToScanBuffer
+    bool colorBufferValid;
+    uint32_t width;
+    uint32_t height;
+    float viewport[4];
+    uint32_t scissor[4];
+} OverlayTargetState;
+
+static OverlayTargetState sTVTargetState  = {};
+static OverlayTargetState sDRCTargetState = {};
+
+static inline OverlayTargetState &getTargetState(GX2ScanTarget scan_target) {
+    return scan_target == GX2_SCAN_TARGET_TV ? sTVTargetState : sDRCTargetState;
+}
+
+static void updateTargetViewport(OverlayTargetState &target, const GX2ColorBuffer *colorBuffer) {
+    if (target.width == colorBuffer->surface.width && target.height == colorBuffer->surface.height) {
+        return;
+    }
+    target.width       = colorBuffer->surface.width;
+    target.height      = colorBuffer->surface.height;
+    target.viewport[0] = 0.0f;
+    target.viewport[1] = 0.0f;
+    target.viewport[2] = (float) target.width;
+    target.viewport[3] = (float) target.height;
+}
+
+static bool colorBufferLayoutMatches(const GX2ColorBuffer *a, const GX2ColorBuffer *b) {
+    return a->surface.dim == b->surface.dim &&
+           a->surface.width == b->surface.width &&
+           a->surface.height == b->surface.height &&
+           a->surface.depth == b->surface.depth &&
+           a->surface.format == b->surface.format &&
+           a->surface.aa == b->surface.aa &&
+           a->surface.tileMode == b->surface.tileMode &&
+           a->surface.swizzle == b->surface.swizzle &&
+           a->aaBuffer == b->aaBuffer &&
+           a->aaSize == b->aaSize;
+}
 DECL_FUNCTION(void, GX2GetCurrentScanBuffer, GX2ScanTarget scanTarget, GX2ColorBuffer *cb) {
     real_GX2GetCurrentScanBuffer(scanTarget, cb);
+    // Only keep a copy if there is (or is about to be) something to draw.
+    bool keepCopy = gOverlayState.load(std::memory_order_acquire) != OVERLAY_STATE_IDLE;
     if (scanTarget == GX2_SCAN_TARGET_TV) {
-        memcpy(&lastTVColorBuffer, cb, sizeof(GX2ColorBuffer));
+        if (keepCopy) {
+            memcpy(&lastTVColorBuffer, cb, sizeof(GX2ColorBuffer));
+        }
+        lastTVColorBufferValid = keepCopy;
     } else {
-        memcpy(&lastDRCColorBuffer, cb, sizeof(GX2ColorBuffer));
+        if (keepCopy) {
+            memcpy(&lastDRCColorBuffer, cb, sizeof(GX2ColorBuffer));
+        }
+        lastDRCColorBufferValid = keepCopy;
     }
 }
 
@@ -43,20 +97,54 @@ DECL_FUNCTION(void, GX2SetDRCBuffer, void *buffer, uint32_t buffer_size, uint32_
     return real_GX2SetDRCBuffer(buffer, buffer_size, drc_mode, surface_format, buffering_mode);
 }
 
+// Limits the scissor of the target to the area that is actually covered by notifications.
+static bool updateTargetScissor(OverlayTargetState &target, OverlayFrame *overlayFrame) {
+    OverlayBounds bounds;
+    if (!overlayFrame->getDrawBounds(bounds)) {
+        return false;
+    }
+    float scaleX = (float) target.width / overlayFrame->getWidth();
+    float scaleY = (float) target.height / overlayFrame->getHeight();
+
+    auto left   = (uint32_t) std::max(floorf(bounds.left * scaleX), 0.0f);
+    auto top    = (uint32_t) std::max(floorf(bounds.top * scaleY), 0.0f);
+    auto right  = std::min((uint32_t) ceilf(bounds.right * scaleX), target.width);
+    auto bottom = std::min((uint32_t) ceilf(bounds.bottom * scaleY), target.height);
+    if (left >= right || top >= bottom) {
+        return false;
+    }
+    target.scissor[0] = left;
+    target.scissor[1] = top;
+    target.scissor[2] = right - left;
+    target.scissor[3] = bottom - top;
+    return true;
+}
+
 void drawIntoColorBuffer(const GX2ColorBuffer *colorBuffer, OverlayFrame *overlayFrame, GX2ScanTarget scan_target) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_OVERLAY_DRAW);
+    auto &target = getTargetState(scan_target);
+    updateTargetViewport(target, colorBuffer);
+    if (!updateTargetScissor(target, overlayFrame)) {
+        // Nothing is visible this frame
+        return;
+    }
+
     real_GX2SetContextState(gContextState);
 
     GX2SetDefaultState();
 
     GX2SetColorBuffer((GX2ColorBuffer *) colorBuffer, GX2_RENDER_TARGET_0);
-    GX2SetViewport(0.0f, 0.0f, colorBuffer->surface.width, colorBuffer->surface.height, 0.0f, 1.0f);
-    GX2SetScissor(0, 0, colorBuffer->surface.width, colorBuffer->surface.height);
+    GX2SetViewport(target.viewport[0], target.viewport[1], target.viewport[2], target.viewport[3], 0.0f, 1.0f);
+    GX2SetScissor(target.scissor[0], target.scissor[1], target.scissor[2], target.scissor[3]);
 
     GX2SetDepthOnlyControl(GX2_FALSE, GX2_FALSE, GX2_COMPARE_FUNC_NEVER);
     GX2SetAlphaTest(GX2_TRUE, GX2_COMPARE_FUNC_GREATER, 0.0f);
     GX2SetColorControl(GX2_LOGIC_OP_COPY, GX2_ENABLE, GX2_DISABLE, GX2_ENABLE);
     auto outputFormat = scan_target ? gTVSurfaceFormat : gDRCSurfaceFormat;
+    auto &gpuTimer    = scan_target == GX2_SCAN_TARGET_TV ? gTVOverlayGPUTimer : gDRCOverlayGPUTimer;
+    gpuTimer.begin();
     overlayFrame->draw(outputFormat & 0x400);
+    gpuTimer.end();
     GX2Flush();
 
     real_GX2SetContextState(gOriginalContextState);
@@ -64,28 +152,27 @@ void drawIntoColorBuffer(const GX2ColorBuffer *colorBuffer, OverlayFrame *overla
 
 
 void drawScreenshotSavedTexture2(GX2ColorBuffer *colorBuffer, GX2ScanTarget scan_target) {
-    if (gOverlayFrame->empty()) {
+    if (!(gOverlayState.load(std::memory_order_acquire) & OVERLAY_STATE_ACTIVE)) {
         return;
     }
 
     drawIntoColorBuffer(colorBuffer, gOverlayFrame, scan_target);
 }
 
-static void TryAddFromQueue() {
-    if (!gOverlayFrame) {
-        return;
-    }
-    std::lock_guard overlay_lock(gOverlayFrameMutex);
-    // Add notification that had been called before the overlay was ready
-    for (const auto &notification : gOverlayQueueDuringStartup) {
-        gOverlayFrame->addNotification(notification);
+static inline void markDrawReady() {
+    if (!gDrawReady) {
+        gDrawReady = true;
+        // Wakes up everyone waiting in NMWaitOverlayReady
+        OSSignalEvent(&gOverlayReadyEvent);
     }
-    gOverlayQueueDuringStartup.clear();
 }
 
 DECL_FUNCTION(void, GX2CopyColorBufferToScanBuffer, const GX2ColorBuffer *colorBuffer, GX2ScanTarget scan_target) {
-    gDrawReady = true;
-    TryAddFromQueue();
+    markDrawReady();
+    if (gOverlayState.load(std::memory_order_acquire) == OVERLAY_STATE_IDLE) {
+        real_GX2CopyColorBufferToScanBuffer(colorBuffer, scan_target);
+        return;
+    }
     if (drawScreenshotSavedTexture(colorBuffer, scan_target)) {
         // if it returns true we don't need to call GX2CopyColorBufferToScanBuffer
         return;
@@ -95,27 +182,32 @@ DECL_FUNCTION(void, GX2CopyColorBufferToScanBuffer, const GX2ColorBuffer *colorB
 }
 
 bool drawScreenshotSavedTexture(const GX2ColorBuffer *colorBuffer, GX2ScanTarget scan_target) {
-    if (gOverlayFrame->empty()) {
+    if (!(gOverlayState.load(std::memory_order_acquire) & OVERLAY_STATE_ACTIVE)) {
         return false;
     }
-    GX2ColorBuffer cb;
-    GX2InitColorBuffer(&cb,
-                       colorBuffer->surface.dim,
-                       colorBuffer->surface.width,
-                       colorBuffer->surface.height,
-                       colorBuffer->surface.depth,
-                       colorBuffer->surface.format,
-                       colorBuffer->surface.aa,
-                       colorBuffer->surface.tileMode,
-                       colorBuffer->surface.swizzle,
-                       colorBuffer->aaBuffer,
-                       colorBuffer->aaSize);
+    auto &target = getTargetState(scan_target);
+    auto *cb     = &target.colorBuffer;
+    // The surface layout only changes if the game switches its render target, so keep the regs around.
+    if (!target.colorBufferValid || !colorBufferLayoutMatches(cb, colorBuffer)) {
+        GX2InitColorBuffer(cb,
+                           colorBuffer->surface.dim,
+                           colorBuffer->surface.width,
+                           colorBuffer->surface.height,
+                           colorBuffer->surface.depth,
+                           colorBuffer->surface.format,
+                           colorBuffer->surface.aa,
+                           colorBuffer->surface.tileMode,
+                           colorBuffer->surface.swizzle,
+                           colorBuffer->aaBuffer,
+                           colorBuffer->aaSize);
+        target.colorBufferValid = true;
+    }
 
-    cb.surface.image = colorBuffer->surface.image;
+    cb->surface.image = colorBuffer->surface.image;
 
-    drawIntoColorBuffer(&cb, gOverlayFrame, scan_target);
+    drawIntoColorBuffer(cb, gOverlayFrame, scan_target);
 
-    real_GX2CopyColorBufferToScanBuffer(&cb, scan_target);
+    real_GX2CopyColorBufferToScanBuffer(cb, scan_target);
 
     return true;
 }
@@ -123,7 +215,6 @@ bool drawScreenshotSavedTexture(const GX2ColorBuffer *colorBuffer, GX2ScanTarget
 DECL_FUNCTION(void, GX2Init, uint32_t attributes) {
     real_GX2Init(attributes);
     if (!gOverlayInitDone) {
-        std::lock_guard overlay_lock(gOverlayFrameMutex);
         DEBUG_FUNCTION_LINE_VERBOSE("Init Overlay");
         gOverlayFrame = new (std::nothrow) OverlayFrame(1280.0f, 720.0f);
         if (!gOverlayFrame) {
@@ -149,21 +240,35 @@ DECL_FUNCTION(void, GX2Init, uint32_t attributes) {
 }
 
 DECL_FUNCTION(void, GX2MarkScanBufferCopied, GX2ScanTarget scan_target) {
-    gDrawReady = true;
-    TryAddFromQueue();
+    markDrawReady();
+    if (gOverlayState.load(std::memory_order_acquire) == OVERLAY_STATE_IDLE) {
+        real_GX2MarkScanBufferCopied(scan_target);
+        return;
+    }
     if (scan_target == GX2_SCAN_TARGET_TV) {
-        drawScreenshotSavedTexture2(&lastTVColorBuffer, scan_target);
+        if (lastTVColorBufferValid) {
+            drawScreenshotSavedTexture2(&lastTVColorBuffer, scan_target);
+        }
     } else {
-        drawScreenshotSavedTexture2(&lastDRCColorBuffer, scan_target);
+        if (lastDRCColorBufferValid) {
+            drawScreenshotSavedTexture2(&lastDRCColorBuffer, scan_target);
+        }
     }
 
     real_GX2MarkScanBufferCopied(scan_target);
 }
 
 DECL_FUNCTION(void, GX2SwapScanBuffers, void) {
-    if (gDrawReady && !gOverlayFrame->empty()) {
-        gOverlayFrame->process();
-        gOverlayFrame->updateEffects();
+    if (gDrawReady && gOverlayState.load(std::memory_order_acquire) != OVERLAY_STATE_IDLE) {
+        ScopedStatisticTimer timer(STATISTIC_TIMER_FRAME_PROCESS);
+        // All animations and timers of this frame are based on a single clock sample
+        OverlayElement::setFrameTime(OSGetSystemTime());
+        // Apply the API requests of the last frame, this never blocks.
+        ProcessNotificationCommands();
+        if (gOverlayState.load(std::memory_order_acquire) & OVERLAY_STATE_ACTIVE) {
+            gOverlayFrame->process();
+            gOverlayFrame->updateEffects();
+        }
     }
     real_GX2SwapScanBuffers();
 }
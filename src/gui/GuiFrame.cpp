@@ -194,6 +194,18 @@ void GuiFrame::process() {
     }
 }
 
+void GuiFrame::invalidateTransform() {
+    // Children are never clean while their parent is dirty, so there is nothing left to do.
+    if (transformDirty) {
+        return;
+    }
+    GuiElement::invalidateTransform();
+
+    for (auto &element : elements) {
+        element->invalidateTransform();
+    }
+}
+
 void GuiFrame::update(GuiController *c) {
     if (isStateSet(STATE_DISABLED) && parentElement) {
         return;
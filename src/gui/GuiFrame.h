@@ -118,6 +118,9 @@ public:
     //!virtual process which is called by the main loop
     virtual void process();
 
+    //!Invalidates the cached transform of the window and all elements contained within
+    void invalidateTransform() override;
+
     //! Signals
     //! On Closing
     sigslot::signal1<GuiFrame *> closing;
@@ -19,13 +19,32 @@
 #include "utils/logger.h"
 #include "utils/utils.h"
 
+static uint8_t *allocColorVtxs(uint32_t size) {
+    // Taken from the pool so bursts of notifications don't hit the mapped memory heap.
+    if (size <= gColorVertexPool.getBlockSize()) {
+        auto *res = (uint8_t *) gColorVertexPool.allocate();
+        if (res) {
+            return res;
+        }
+    }
+    return (uint8_t *) MEMAllocFromMappedMemoryForGX2Ex(size, GX2_VERTEX_BUFFER_ALIGNMENT);
+}
+
+static void freeColorVtxs(uint8_t *ptr) {
+    if (gColorVertexPool.owns(ptr)) {
+        gColorVertexPool.free(ptr);
+    } else {
+        MEMFreeToMappedMemory(ptr);
+    }
+}
+
 GuiImage::GuiImage(int32_t w, int32_t h, const GX2Color &c, int32_t type) {
     internalInit(w, h);
     imgType    = type;
     colorCount = ColorShader::cuColorVtxsSize / ColorShader::cuColorAttrSize;
 
-    colorVtxs          = (uint8_t *) MEMAllocFromMappedMemoryForGX2Ex(colorCount * ColorShader::cuColorAttrSize, GX2_VERTEX_BUFFER_ALIGNMENT);
-    colorVtxsCorrected = (uint8_t *) MEMAllocFromMappedMemoryForGX2Ex(colorCount * ColorShader::cuColorAttrSize, GX2_VERTEX_BUFFER_ALIGNMENT);
+    colorVtxs          = allocColorVtxs(colorCount * ColorShader::cuColorAttrSize);
+    colorVtxsCorrected = allocColorVtxs(colorCount * ColorShader::cuColorAttrSize);
     if (colorVtxs && colorVtxsCorrected) {
         for (uint32_t i = 0; i < colorCount; i++) {
             setImageColor(c, i);
@@ -43,8 +62,8 @@ GuiImage::GuiImage(int32_t w, int32_t h, const GX2Color *c, uint32_t color_count
         colorCount = color_count;
     }
 
-    colorVtxs          = (uint8_t *) MEMAllocFromMappedMemoryForGX2Ex(colorCount * ColorShader::cuColorAttrSize, GX2_VERTEX_BUFFER_ALIGNMENT);
-    colorVtxsCorrected = (uint8_t *) MEMAllocFromMappedMemoryForGX2Ex(colorCount * ColorShader::cuColorAttrSize, GX2_VERTEX_BUFFER_ALIGNMENT);
+    colorVtxs          = allocColorVtxs(colorCount * ColorShader::cuColorAttrSize);
+    colorVtxsCorrected = allocColorVtxs(colorCount * ColorShader::cuColorAttrSize);
     if (colorVtxs && colorVtxsCorrected) {
         for (uint32_t i = 0; i < colorCount; i++) {
             // take the last as reference if not enough colors defined
@@ -61,11 +80,11 @@ GuiImage::GuiImage(int32_t w, int32_t h, const GX2Color *c, uint32_t color_count
  */
 GuiImage::~GuiImage() {
     if (colorVtxs) {
-        MEMFreeToMappedMemory(colorVtxs);
+        freeColorVtxs(colorVtxs);
         colorVtxs = nullptr;
     }
     if (colorVtxsCorrected) {
-        MEMFreeToMappedMemory(colorVtxsCorrected);
+        freeColorVtxs(colorVtxsCorrected);
         colorVtxsCorrected = nullptr;
     }
 }
@@ -123,8 +142,12 @@ void GuiImage::setImageColor(const GX2Color &c, int32_t idx) {
 }
 
 void GuiImage::setSize(float w, float h) {
+    if (width == w && height == h) {
+        return;
+    }
     width  = w;
     height = h;
+    invalidateTransform();
 }
 
 #define DegToRad(a) ((a) *0.01745329252f)
@@ -18,10 +18,10 @@
 
 #include "shaders/Shader.h"
 #include "shaders/gx2_ext.h"
-#include <gui/GuiElement.h>
+#include <gui/OverlayElement.h>
 
 //!Display, manage, and manipulate images in the GUI
-class GuiImage : public GuiElement {
+class GuiImage final : public OverlayElement {
 public:
     enum ImageTypes {
         IMAGE_COLOR
@@ -122,6 +122,7 @@ void GuiText::setFontSize(int s) {
 void GuiText::setColor(const glm::vec4 &c) {
     color = c;
     alpha = c[3];
+    invalidateTransform();
 
     colorCorrected = {SRGBComponentToRGB((uint8_t) (color.r * 255.0f)) / 255.0f,
                       SRGBComponentToRGB((uint8_t) (color.g * 255.0f)) / 255.0f,
@@ -202,5 +203,5 @@ void GuiText::updateTextSize() {
 }
 
 void GuiText::process() {
-    GuiElement::process();
+    OverlayElement::process();
 }
@@ -16,13 +16,13 @@
  ****************************************************************************/
 #pragma once
 
-#include "GuiElement.h"
+#include "OverlayElement.h"
 #include <mutex>
 //!Forward declaration
 class SchriftGX2;
 
 //!Display, manage, and manipulate text in the GUI
-class GuiText : public GuiElement {
+class GuiText final : public OverlayElement {
 public:
     //!Constructor
     GuiText();
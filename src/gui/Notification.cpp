@@ -1,4 +1,7 @@
 #include "Notification.h"
+#include "callback_dispatcher.h"
+#include "utils/Statistics.h"
+#include <cstdio>
 
 Notification::Notification(const std::string &overlayText,
                            NotificationStatus status,
@@ -9,12 +12,14 @@ Notification::Notification(const std::string &overlayText,
                            void (*finishFunc)(NotificationModuleHandle, void *),
                            void *context,
                            void (*removedFromOverlayCallback)(Notification *),
-                           bool keepUntilShown) : GuiFrame(0, 0), mBackground(0, 0, backgroundColor) {
+                           bool keepUntilShown) : mBackground(0, 0, backgroundColor) {
     mFinishFunction              = finishFunc;
     mFinishFunctionContext       = context;
     mRemovedFromOverlayCallback  = removedFromOverlayCallback;
     mDelayBeforeFadeoutInSeconds = delayBeforeFadeoutInSeconds;
     mShakeDurationInSeconds      = shakeDuration;
+    mBackgroundColor             = backgroundColor;
+    mTextColor                   = textColor;
     mBackground.setImageColor(backgroundColor);
 
     mNotificationText.setColor({textColor.r / 255.0f, textColor.g / 255.0f, textColor.b / 255.0f, textColor.a / 255.0f});
@@ -31,27 +36,32 @@ Notification::Notification(const std::string &overlayText,
 
     mWaitForReset = true;
 
-    append(&mBackground);
-    append(&mNotificationText);
+    mBackground.setParent(this);
+    mNotificationText.setParent(this);
+
+    StatisticsNotificationCreated();
 }
 
 Notification::~Notification() {
     finishFunction();
-    remove(&mNotificationText);
-    remove(&mBackground);
+
+    StatisticsNotificationDestroyed();
 }
 
 void Notification::process() {
-    GuiFrame::process();
+    // The children are known, call them directly instead of iterating the GuiFrame elements
+    OverlayElement::process();
+    mBackground.process();
+    mNotificationText.process();
 
     if (mWaitForReset) {
-        mTimer.reset();
+        mWaitStart    = getFrameTime();
         mWaitForReset = false;
         return;
     }
 
     if (mInternalStatus == NOTIFICATION_STATUS_WAIT) {
-        if (mTimer.elapsed() >= mDelayBeforeFadeoutInSeconds) {
+        if (TicksToSeconds(getFrameTime() - mWaitStart) >= mDelayBeforeFadeoutInSeconds) {
             mInternalStatus = NOTIFICATION_STATUS_REQUESTED_FADE_OUT_AND_EXIT;
         }
     }
@@ -59,26 +69,106 @@ void Notification::process() {
 
 void Notification::finishFunction() {
     if (!mFinishFunctionCalled && mFinishFunction) {
-        mFinishFunction(this->getHandle(), mFinishFunctionContext);
+        // Never run plugin code on the render thread (or wherever the last reference is dropped)
+        DispatchNotificationCallback(mFinishFunction, this->getHandle(), mFinishFunctionContext);
         mFinishFunctionCalled = true;
     }
 }
 
+static inline bool colorEquals(const GX2Color &a, const GX2Color &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool Notification::canMerge(const Notification &other) const {
+    // Only static notifications without callbacks, the caller of a merged notification would never get them.
+    if (mHandle != 0 || other.mHandle != 0 || other.mFinishFunction != nullptr || other.mShownFunction != nullptr) {
+        return false;
+    }
+    if (mExiting || mStatus != other.mStatus || mStack != other.mStack) {
+        return false;
+    }
+    return colorEquals(mTextColor, other.mTextColor) && colorEquals(mBackgroundColor, other.mBackgroundColor) && mText == other.mText;
+}
+
+void Notification::addRepeat() {
+    mRepeatCount++;
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), " \xC3\x97%u", (unsigned int) mRepeatCount); // " ×N"
+    std::string text = mText + suffix;
+    mNotificationText.setText(text.c_str());
+    mTextDirty = true;
+    if (mInternalStatus == NOTIFICATION_STATUS_WAIT) {
+        mWaitForReset = true;
+    }
+}
+
+bool Notification::updateSize() {
+    if (!mTextDirty) {
+        return false;
+    }
+    mNotificationText.updateTextSize();
+    mTextDirty = false;
+
+    float newWidth  = (float) mNotificationText.getTextWidth() + 25;
+    float newHeight = (float) mNotificationText.getTextHeight() + 25;
+    if (newWidth == width && newHeight == height) {
+        return false;
+    }
+    width  = newWidth;
+    height = newHeight;
+    mBackground.setSize(width, height);
+    invalidateTransform();
+    return true;
+}
+
 void Notification::draw(bool SRGBConversion) {
+    // The size is measured by the stack before the notification is positioned
     if (!mPositionSet) {
         return;
     }
-    if (mTextDirty) {
-        mNotificationText.updateTextSize();
-        mTextDirty = false;
+    if (hasSize()) {
+        if (!isVisible()) {
+            return;
+        }
+        mBackground.draw(SRGBConversion);
+        mNotificationText.draw(SRGBConversion);
+        if (!mShownFunctionCalled) {
+            DispatchNotificationCallback(mShownFunction, this->getHandle(), mFinishFunctionContext);
+            mShownFunctionCalled = true;
+        }
     }
-    width  = (float) mNotificationText.getTextWidth() + 25;
-    height = (float) mNotificationText.getTextHeight() + 25;
+}
 
-    mBackground.setSize(width, height);
-    if (width > 25 || height > 25) {
-        GuiFrame::draw(SRGBConversion);
+void Notification::startEffect(int32_t effect, float durationInSeconds, TweenEasing easing, NotificationInternalStatus next) {
+    resetEffects();
+    setEffect(effect, durationInSeconds, 0, easing);
+    mInternalStatus    = NOTIFICATION_STATUS_EFFECT;
+    mStatusAfterEffect = next;
+}
+
+void Notification::onEffectFinished() {
+    // The fade in is not started via startEffect and must not change the status
+    if (mInternalStatus == NOTIFICATION_STATUS_EFFECT) {
+        mInternalStatus = mStatusAfterEffect;
+    }
+}
+
+void Notification::updateEffects() {
+    if (!isVisible()) {
+        return;
+    }
+    OverlayElement::updateEffects();
+    mBackground.updateEffects();
+    mNotificationText.updateEffects();
+}
+
+void Notification::invalidateTransform() {
+    if (transformDirty) {
+        return;
     }
+    OverlayElement::invalidateTransform();
+    mBackground.invalidateTransform();
+    mNotificationText.invalidateTransform();
 }
 
 void Notification::updateStatus(NotificationStatus newStatus) {
@@ -1,8 +1,6 @@
 #pragma once
-#include "GuiFrame.h"
 #include "GuiImage.h"
 #include "GuiText.h"
-#include "Timer.h"
 #include "utils/logger.h"
 #include <notifications/notification_defines.h>
 
@@ -21,12 +19,25 @@ typedef enum {
     NOTIFICATION_STATUS_REQUESTED_EXIT,
 } NotificationInternalStatus;
 
-class OverlayFrame;
+//! Anchors of the overlay, every anchor has its own stack of notifications
+typedef enum {
+    OVERLAY_STACK_TOP_LEFT,
+    OVERLAY_STACK_TOP_RIGHT,
+    OVERLAY_STACK_BOTTOM_LEFT,
+    OVERLAY_STACK_BOTTOM_RIGHT,
+    OVERLAY_STACK_TOP_CENTER,
+    OVERLAY_STACK_PROGRESS, //!< Bottom center, meant for in progress notifications
+    OVERLAY_STACK_COUNT,
+} OverlayStackId;
+
+class NotificationStack;
 
-class Notification : public GuiFrame {
+//! final, so calls through Notification pointers (see NotificationStore) and to the
+//! GuiImage / GuiText members are resolved at compile time and can be inlined.
+class Notification final : public OverlayElement {
 
 public:
-    friend class OverlayFrame;
+    friend class NotificationStack;
     explicit Notification(const std::string &overlayText,
                           NotificationStatus status                            = NOTIFICATION_STATUS_INFO,
                           float delayBeforeFadeoutInSeconds                    = 2.0f,
@@ -42,33 +53,91 @@ public:
 
     void process() override;
     void draw(bool SRGBConversion) override;
+    void updateEffects() override;
+    void invalidateTransform() override;
+
+    //!Measures the text and resizes the notification, only if the text or the font size has changed since the last call
+    //!\return true if the size has changed
+    bool updateSize();
+
+    //!\return true if the notification has been measured and is big enough to be drawn
+    [[nodiscard]] bool hasSize() const {
+        return width > 25 || height > 25;
+    }
 
     void finishFunction();
 
+    //!Makes sure neither the finish nor the shown callback is ever called, for notifications that have never been accepted by the overlay
+    void cancelCallbacks() {
+        mFinishFunctionCalled = true;
+        mShownFunction        = nullptr;
+    }
+
+    //!func is called (with the context of the finish function) once the notification has been drawn for the first time
+    void setShownCallback(void (*func)(NotificationModuleHandle, void *)) {
+        mShownFunction = func;
+    }
+
     void updateText(const char *text) {
+        mText = text != nullptr ? text : "";
         mNotificationText.setText(text);
         mTextDirty = true;
         OSMemoryBarrier();
     }
 
     void updateBackgroundColor(GX2Color color) {
+        mBackgroundColor = color;
         mBackground.setImageColor(color);
         OSMemoryBarrier();
     }
 
     void updateTextColor(GX2Color textColor) {
+        mTextColor = textColor;
         mNotificationText.setColor({textColor.r / 255.0f, textColor.g / 255.0f, textColor.b / 255.0f, textColor.a / 255.0f});
         OSMemoryBarrier();
     }
 
+    //!\return true if other is a repetition of this notification and can be merged via addRepeat
+    [[nodiscard]] bool canMerge(const Notification &other) const;
+
+    //!Counts another occurrence, shows "×N" and restarts the timer
+    void addRepeat();
+
     void updateStatus(NotificationStatus newStatus);
 
+    //!\return true if this is a dynamic notification that has been finished via the API
+    [[nodiscard]] bool isFinishRequested() const {
+        return mHandle != 0 && mStatus != NOTIFICATION_STATUS_IN_PROGRESS;
+    }
+
+    void updateFontSize(int32_t size) {
+        mNotificationText.setFontSize(size);
+        mTextDirty = true;
+    }
+
     NotificationStatus getStatus() {
         return mStatus;
     }
 
+    //!\return priority derived from the status: error > info > in progress
+    [[nodiscard]] uint32_t getPriority() const {
+        switch (mStatus) {
+            case NOTIFICATION_STATUS_ERROR:
+                return 2;
+            case NOTIFICATION_STATUS_INFO:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
     uint32_t getHandle() {
-        return (uint32_t) this;
+        // Notifications without an entry in the handle table are identified by their address
+        return mHandle != 0 ? mHandle : (uint32_t) this;
+    }
+
+    void setHandle(uint32_t handle) {
+        mHandle = handle;
     }
 
     void updateWaitDuration(float duration) {
@@ -87,32 +156,60 @@ public:
     }
 
     void setPosition(float x, float y) override {
-        GuiElement::setPosition(x, y);
+        OverlayElement::setPosition(x, y);
         mPositionSet = true;
     }
 
+    //!Selects the stack the notification is shown in, has no effect once it has been added to the overlay
+    void setStack(OverlayStackId stack) {
+        mStack = stack;
+    }
+
+    [[nodiscard]] OverlayStackId getStack() const {
+        return mStack;
+    }
+
     [[nodiscard]] bool isKeepUntilShown() const {
         return mKeepUntilShown;
     }
 
+    //!Replaces the running effect, the internal status changes to next once the new effect has finished
+    void startEffect(int32_t effect, float durationInSeconds, TweenEasing easing, NotificationInternalStatus next);
+
+protected:
+    void onEffectFinished() override;
+
 private:
-    std::function<void(NotificationModuleHandle, void *)> mFinishFunction;
-    std::function<void(Notification *)> mRemovedFromOverlayCallback;
+    void (*mFinishFunction)(NotificationModuleHandle, void *) = nullptr;
+    void (*mRemovedFromOverlayCallback)(Notification *)       = nullptr;
+    void (*mShownFunction)(NotificationModuleHandle, void *)  = nullptr;
 
     void *mFinishFunctionContext;
     GuiImage mBackground;
     GuiText mNotificationText;
-    Timer mTimer;
+    OSTime mWaitStart = 0; //!< frame time the wait for the fade out has started at
     float mDelayBeforeFadeoutInSeconds;
     float mShakeDurationInSeconds;
     bool mFinishFunctionCalled = false;
+    bool mShownFunctionCalled  = false;
     bool mWaitForReset         = false;
 
-    bool mTextDirty   = false;
+    bool mTextDirty   = true; //!< the cached size is outdated, set by changes of the text or the font size
     bool mPositionSet = false;
 
     bool mKeepUntilShown = false;
 
-    NotificationStatus mStatus                 = NOTIFICATION_STATUS_INFO;
-    NotificationInternalStatus mInternalStatus = NOTIFICATION_STATUS_NOTHING;
+    std::string mText;
+    GX2Color mTextColor       = {};
+    GX2Color mBackgroundColor = {};
+    uint32_t mRepeatCount     = 1;
+    bool mExiting             = false; //!< fade out has started
+
+    uint32_t mHandle = 0;
+
+    OverlayStackId mStack = OVERLAY_STACK_TOP_LEFT;
+
+    NotificationStatus mStatus                    = NOTIFICATION_STATUS_INFO;
+    NotificationInternalStatus mInternalStatus    = NOTIFICATION_STATUS_NOTHING;
+    NotificationInternalStatus mStatusAfterEffect = NOTIFICATION_STATUS_NOTHING; //!< mInternalStatus once the running effect has finished
 };
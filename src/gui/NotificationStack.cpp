@@ -0,0 +1,399 @@
+#include "NotificationStack.h"
+#include "notification_commands.h"
+#include "retain_vars.hpp"
+#include "utils/Statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+//! Durations of the notification animations, in seconds
+#define NOTIFICATION_FADE_IN_DURATION   0.1f
+#define NOTIFICATION_SLIDE_OUT_DURATION 0.2f
+
+//! Distance of the stacks to the edges of the overlay and between two notifications
+#define STACK_MARGIN                    25.0f
+#define STACK_SPACING                   10.0f
+
+typedef struct NotificationStackLayout {
+    int32_t alignment;  //!< of the notifications relative to the overlay
+    float x;            //!< horizontal offset of all notifications
+    bool growsUp;       //!< true for stacks at the bottom edge, the newest notification is at the bottom then
+    int32_t exitEffect; //!< towards the nearest edge, center stacks fade out
+} NotificationStackLayout;
+
+//! Indexed by OverlayStackId
+static const NotificationStackLayout sStackLayouts[OVERLAY_STACK_COUNT] = {
+        {ALIGN_TOP_LEFT, STACK_MARGIN, false, EFFECT_SLIDE_LEFT | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM},
+        {ALIGN_TOP_RIGHT, -STACK_MARGIN, false, EFFECT_SLIDE_RIGHT | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM},
+        {ALIGN_LEFT | ALIGN_BOTTOM, STACK_MARGIN, true, EFFECT_SLIDE_LEFT | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM},
+        {ALIGN_RIGHT | ALIGN_BOTTOM, -STACK_MARGIN, true, EFFECT_SLIDE_RIGHT | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM},
+        {ALIGN_TOP_CENTER, 0.0f, false, EFFECT_FADE},
+        {ALIGN_CENTER | ALIGN_BOTTOM, 0.0f, true, EFFECT_FADE},
+};
+
+NotificationStack::NotificationStack() : summaryBackground(0, 0, (GX2Color){100, 100, 100, 255}) {
+    summaryText.setParent(&summaryBackground);
+    summaryText.setFontSize(20);
+    summaryText.setAlignment(ALIGN_CENTERED);
+}
+
+void NotificationStack::init(OverlayElement *parentElement, OverlayStackId stackId) {
+    parent = parentElement;
+    id     = stackId;
+    store.reserve(OVERLAY_DEFAULT_MAX_VISIBLE);
+
+    summaryBackground.setParent(parent);
+    summaryBackground.setAlignment(sStackLayouts[id].alignment);
+}
+
+bool NotificationStack::mergeNotification(const std::shared_ptr<Notification> &status) {
+    for (auto *item : store.items) {
+        if (item->canMerge(*status)) {
+            item->addRepeat();
+            return true;
+        }
+    }
+    for (auto &item : queued) {
+        if (item->canMerge(*status)) {
+            item->addRepeat();
+            return true;
+        }
+    }
+    return false;
+}
+
+void NotificationStack::addNotification(std::shared_ptr<Notification> status) {
+    if (mergeNotification(status)) {
+        // The repetition is dropped here and only bumps the counter of the existing entry.
+        return;
+    }
+    uint32_t maxVisible = gOverlayMaxVisible[id].load(std::memory_order_relaxed);
+    if (store.size() < maxVisible) {
+        showNotification(std::move(status));
+        return;
+    }
+    switch ((OverlayOverflowPolicy) gOverlayOverflowPolicy.load(std::memory_order_relaxed)) {
+        case OVERLAY_OVERFLOW_POLICY_DROP_OLDEST:
+            evictVisibleNotification(false, 0);
+            showNotification(std::move(status));
+            break;
+        case OVERLAY_OVERFLOW_POLICY_DROP_LOWEST:
+            if (evictVisibleNotification(true, status->getPriority())) {
+                showNotification(std::move(status));
+            } else {
+                dropNotification(status);
+            }
+            break;
+        case OVERLAY_OVERFLOW_POLICY_QUEUE:
+        default:
+            queueNotification(std::move(status));
+            break;
+    }
+}
+
+void NotificationStack::showNotification(std::shared_ptr<Notification> status) {
+    // Notifications are not appended to the GuiFrame, the store replaces the list of elements.
+    status->setParent(parent);
+    status->setAlignment(sStackLayouts[id].alignment);
+    status->setEffect(EFFECT_FADE, NOTIFICATION_FADE_IN_DURATION, 255, TWEEN_EASE_OUT_QUAD);
+    markLayoutDirty((int32_t) store.add(std::move(status)));
+    gOverlayState.fetch_or(OVERLAY_STATE_ACTIVE);
+}
+
+void NotificationStack::removeNotification(uint32_t index) {
+    store.items[index]->setParent(nullptr);
+    store.removeAt(index);
+    markLayoutDirty((int32_t) index - 1);
+}
+
+void NotificationStack::dropNotification(const std::shared_ptr<Notification> &status) {
+    status->callDeleteCallback();
+    StatisticsAddDroppedNotification();
+}
+
+bool NotificationStack::evictVisibleNotification(bool lowestPriority, uint32_t maxPriority) {
+    // The store is ordered oldest first, so the first match is the oldest one.
+    int32_t victim          = -1;
+    uint32_t victimPriority = 0;
+    for (uint32_t i = 0; i < store.size(); i++) {
+        uint32_t priority = store.priorities[i];
+        if (lowestPriority && priority > maxPriority) {
+            continue;
+        }
+        if (victim < 0 || priority < victimPriority) {
+            victim         = (int32_t) i;
+            victimPriority = priority;
+        }
+        if (!lowestPriority) {
+            break;
+        }
+    }
+    if (victim < 0) {
+        return false;
+    }
+    dropNotification(store.owners[victim]);
+    removeNotification(victim);
+    return true;
+}
+
+void NotificationStack::queueNotification(std::shared_ptr<Notification> status) {
+    if (queued.size() >= OVERLAY_MAX_QUEUED) {
+        // Drop the oldest entry with the lowest priority, which might be the new one.
+        auto victim = std::min_element(queued.begin(), queued.end(), [](const auto &a, const auto &b) {
+            return a->getPriority() < b->getPriority();
+        });
+        if ((*victim)->getPriority() > status->getPriority()) {
+            dropNotification(status);
+            return;
+        }
+        dropNotification(*victim);
+        queued.erase(victim);
+    }
+    queued.push_back(std::move(status));
+}
+
+void NotificationStack::showQueuedNotifications() {
+    uint32_t maxVisible = gOverlayMaxVisible[id].load(std::memory_order_relaxed);
+    while (!queued.empty() && store.size() < maxVisible) {
+        // Highest priority first, oldest first for equal priorities
+        auto next = std::max_element(queued.begin(), queued.end(), [](const auto &a, const auto &b) {
+            return a->getPriority() < b->getPriority();
+        });
+        auto status = std::move(*next);
+        queued.erase(next);
+        showNotification(std::move(status));
+    }
+}
+
+void NotificationStack::clear() {
+    // Parked and queued notifications may have never been shown, hand them back so ExportCleanUp can keep them.
+    for (uint32_t i = 0; i < store.size(); i++) {
+        auto *item = store.items[i];
+        item->setParent(nullptr);
+        if (item->isKeepUntilShown() && !item->mShownFunctionCalled) {
+            requeueNotification(std::move(store.owners[i]));
+        }
+    }
+    store.clear();
+    summaryCount    = 0;
+    layoutDirtyFrom = -1;
+    for (auto &element : queued) {
+        if (element->isKeepUntilShown()) {
+            requeueNotification(std::move(element));
+        }
+    }
+    queued.clear();
+}
+
+void NotificationStack::requeueNotification(std::shared_ptr<Notification> status) {
+    NotificationCommand command;
+    command.type         = NOTIFICATION_COMMAND_ADD;
+    command.handle       = status->mHandle;
+    command.notification = std::move(status);
+    PushNotificationCommand(command);
+}
+
+void NotificationStack::markLayoutDirty(int32_t index) {
+    // Removing the oldest entry still changes the parked count
+    layoutDirtyFrom = std::max(layoutDirtyFrom, std::max(index, 0));
+}
+
+void NotificationStack::process() {
+    const auto &layout = sStackLayouts[id];
+
+    // Newest first, parked entries are neither processed nor animated
+    for (int32_t i = (int32_t) store.size() - 1; i >= 0; i--) {
+        auto *item          = store.items[i];
+        store.priorities[i] = item->getPriority();
+        if (store.parked[i]) {
+            if (item->isFinishRequested()) {
+                // Its timer is paused, so it would never fade out. Nobody would see the exit effect anyway,
+                // the removal updates the summary with the next layout.
+                item->mExiting = true;
+                item->finishFunction();
+                item->mInternalStatus = NOTIFICATION_STATUS_REQUESTED_EXIT;
+            }
+            continue;
+        }
+        item->process();
+
+        if (item->mInternalStatus == NOTIFICATION_STATUS_REQUESTED_FADE_OUT_AND_EXIT) {
+            item->startEffect(layout.exitEffect, NOTIFICATION_SLIDE_OUT_DURATION, TWEEN_EASE_IN_QUAD, NOTIFICATION_STATUS_REQUESTED_EXIT);
+            item->mExiting = true;
+            item->finishFunction();
+        } else if (item->mInternalStatus == NOTIFICATION_STATUS_REQUESTED_SHAKE) {
+            item->startEffect(EFFECT_SHAKE, item->mShakeDurationInSeconds, TWEEN_EASE_LINEAR, NOTIFICATION_STATUS_WAIT);
+        }
+    }
+    // Reclaim every finished notification in this frame
+    uint32_t removed = 0;
+    store.removeIf([this, &removed](uint32_t i) {
+        auto *item = store.items[i];
+        if (item->mInternalStatus != NOTIFICATION_STATUS_REQUESTED_EXIT) {
+            return false;
+        }
+        item->callDeleteCallback();
+        item->setParent(nullptr);
+        // The older entries keep their order and end up below i - removed
+        markLayoutDirty((int32_t) (i - removed) - 1);
+        removed++;
+        return true;
+    });
+    showQueuedNotifications();
+
+    // Only text and font size changes resize a notification, usually nothing is measured here
+    for (uint32_t i = 0; i < store.size(); i++) {
+        auto *item = store.items[i];
+        if (item->updateSize()) {
+            store.heights[i] = item->getHeight();
+            markLayoutDirty((int32_t) i);
+        }
+    }
+    if (layoutDirtyFrom >= 0) {
+        updateLayout();
+    }
+}
+
+void NotificationStack::updateLayout() {
+    const auto &layout = sStackLayouts[id];
+
+    // The newest notification is next to the edge, older ones are pushed away from it.
+    // Positions are signed distances from the anchor edge, entries that would end beyond maxDistance are parked, all older ones as well.
+    auto newest       = (int32_t) store.size() - 1;
+    auto from         = std::min(layoutDirtyFrom, newest);
+    float direction   = layout.growsUp ? 1.0f : -1.0f;
+    float distance    = STACK_MARGIN;
+    float maxDistance = parent->getHeight() - OVERLAY_SUMMARY_RESERVE;
+    bool parking      = false;
+    layoutDirtyFrom   = -1;
+    if (from < newest) {
+        // Continue right after the next newer entry, which has not moved
+        if (store.parked[from + 1]) {
+            parking = true;
+        } else {
+            distance = std::fabs(store.positions[from + 1]) + store.heights[from + 1] + STACK_SPACING;
+        }
+    }
+    for (int32_t i = from; i >= 0; i--) {
+        auto *item = store.items[i];
+        if (parking || (i != newest && distance + store.heights[i] > maxDistance)) {
+            if (!parking) {
+                summaryOffset = direction * distance;
+                parking       = true;
+            }
+            store.parked[i] = 1;
+            continue;
+        }
+        if (store.parked[i]) {
+            // The timer is paused while parked, show it for the full duration and fade it in again.
+            store.parked[i]     = 0;
+            item->mWaitForReset = true;
+            if (item->getEffect() == EFFECT_NONE) {
+                item->setEffect(EFFECT_FADE, NOTIFICATION_FADE_IN_DURATION, 255, TWEEN_EASE_OUT_QUAD);
+            }
+        }
+        float offset = direction * distance;
+        if (store.positions[i] != offset) {
+            store.positions[i] = offset;
+            item->setPosition(layout.x, offset);
+        }
+        distance += store.heights[i] + STACK_SPACING;
+    }
+
+    uint32_t parkedCount = 0;
+    for (auto parked : store.parked) {
+        parkedCount += parked;
+    }
+    updateSummary(parkedCount, summaryOffset);
+}
+
+void NotificationStack::updateSummary(uint32_t parkedCount, float offset) {
+    if (parkedCount == 0 || store.empty()) {
+        summaryCount = 0;
+        return;
+    }
+    if (parkedCount != summaryCount) {
+        char text[32];
+        snprintf(text, sizeof(text), "+%u more", (unsigned int) parkedCount);
+        summaryText.setText(text);
+        summaryText.updateTextSize();
+        summaryBackground.setSize((float) summaryText.getTextWidth() + 25, (float) summaryText.getTextHeight() + 25);
+        summaryText.invalidateTransform();
+        summaryCount = parkedCount;
+    }
+    if (summaryBackground.getOffsetY() != offset) {
+        summaryBackground.setPosition(sStackLayouts[id].x, offset);
+        summaryText.invalidateTransform();
+    }
+}
+
+void NotificationStack::updateEffects() {
+    for (uint32_t i = 0; i < store.size(); i++) {
+        if (!store.parked[i]) {
+            store.items[i]->updateEffects();
+        }
+    }
+}
+
+void NotificationStack::draw(bool SRGBConversion) {
+    // Oldest first, newer notifications are drawn on top
+    for (uint32_t i = 0; i < store.size(); i++) {
+        if (!store.parked[i]) {
+            store.items[i]->draw(SRGBConversion);
+        }
+    }
+    if (summaryCount > 0) {
+        summaryBackground.draw(SRGBConversion);
+        summaryText.draw(SRGBConversion);
+    }
+}
+
+void NotificationStack::invalidateTransform() {
+    for (auto *item : store.items) {
+        item->invalidateTransform();
+    }
+    summaryBackground.invalidateTransform();
+    summaryText.invalidateTransform();
+}
+
+void NotificationStack::addDrawBounds(OverlayBounds &bounds, bool &boundsEmpty, float frameWidth, float frameHeight) {
+    // Covers the small offsets of the shake effect
+    constexpr float margin = 4.0f;
+
+    int32_t alignment = sStackLayouts[id].alignment;
+    for (uint32_t i = 0; i <= store.size(); i++) {
+        // The last iteration covers the summary
+        OverlayElement *item;
+        if (i < store.size()) {
+            if (store.parked[i] || !store.items[i]->isVisible() || !store.items[i]->hasSize()) {
+                continue;
+            }
+            item = store.items[i];
+        } else if (summaryCount > 0) {
+            item = &summaryBackground;
+        } else {
+            break;
+        }
+        float w  = item->getWidth() * item->getScaleX();
+        float h  = item->getHeight() * item->getScaleY();
+        float cx = frameWidth * 0.5f + item->getCenterX();
+        float cy = frameHeight * 0.5f - item->getCenterY();
+
+        OverlayBounds cur = {cx - w * 0.5f - margin, cy - h * 0.5f - margin, cx + w * 0.5f + margin, cy + h * 0.5f + margin};
+        // Notifications slide out towards their edge, extend the area up to it.
+        if (alignment & ALIGN_LEFT) {
+            cur.left = 0.0f;
+        } else if (alignment & ALIGN_RIGHT) {
+            cur.right = frameWidth;
+        }
+        if (boundsEmpty) {
+            bounds      = cur;
+            boundsEmpty = false;
+        } else {
+            bounds.left   = std::min(bounds.left, cur.left);
+            bounds.top    = std::min(bounds.top, cur.top);
+            bounds.right  = std::max(bounds.right, cur.right);
+            bounds.bottom = std::max(bounds.bottom, cur.bottom);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "GuiImage.h"
+#include "GuiText.h"
+#include "Notification.h"
+#include "NotificationStore.h"
+#include <deque>
+#include <memory>
+
+typedef enum {
+    OVERLAY_OVERFLOW_POLICY_QUEUE,       //!< Show it once a visible notification has been removed, higher priorities first
+    OVERLAY_OVERFLOW_POLICY_DROP_OLDEST, //!< Remove the oldest visible notification
+    OVERLAY_OVERFLOW_POLICY_DROP_LOWEST, //!< Remove the visible notification with the lowest priority (oldest first), or drop the new one if it has a lower priority
+} OverlayOverflowPolicy;
+
+#define OVERLAY_DEFAULT_MAX_VISIBLE 16
+//! Upper limit of notifications waiting for OVERLAY_OVERFLOW_POLICY_QUEUE, the lowest priority is dropped beyond that
+#define OVERLAY_MAX_QUEUED          64
+//! Space at the far end of a stack that is kept free for the "+N more" summary of parked notifications
+#define OVERLAY_SUMMARY_RESERVE     60.0f
+
+//! Rectangle in overlay coordinates, origin is the top left corner
+typedef struct OverlayBounds {
+    float left;
+    float top;
+    float right;
+    float bottom;
+} OverlayBounds;
+
+//! Notifications of one anchor of the overlay, with its own layout, capacity limit and queue.
+class NotificationStack {
+public:
+    NotificationStack();
+
+    //!Anchors the stack in parent, has to be called once before anything is added
+    void init(OverlayElement *parent, OverlayStackId id);
+
+    //!Shows the notification, or applies the overflow policy if the stack is full already
+    void addNotification(std::shared_ptr<Notification> status);
+
+    //!Updates timers, removes finished notifications and reflows the stack if something has changed
+    void process();
+
+    void updateEffects();
+
+    void draw(bool SRGBConversion);
+
+    void invalidateTransform();
+
+    //!Removes all notifications, keep-until-shown notifications that have never been drawn are handed back to the command queue
+    void clear();
+
+    [[nodiscard]] bool empty() const {
+        return store.empty();
+    }
+
+    //!Extends bounds (in a frame of frameWidth x frameHeight) by the area covered by this stack
+    //!\param boundsEmpty true if bounds does not contain anything yet
+    void addDrawBounds(OverlayBounds &bounds, bool &boundsEmpty, float frameWidth, float frameHeight);
+
+private:
+    void showNotification(std::shared_ptr<Notification> status);
+
+    //!Merges a repetition of a live static notification into it
+    //!\return true if status has been merged and must not be added
+    bool mergeNotification(const std::shared_ptr<Notification> &status);
+
+    //!Removes the visible notification at index
+    void removeNotification(uint32_t index);
+
+    //!Removes the oldest visible notification with a priority <= maxPriority (or the oldest overall if lowestPriority is false)
+    //!\return false if there is no such notification
+    bool evictVisibleNotification(bool lowestPriority, uint32_t maxPriority);
+
+    void queueNotification(std::shared_ptr<Notification> status);
+
+    void showQueuedNotifications();
+
+    //!Entries at index and below (older ones) have to be positioned again by the next updateLayout()
+    void markLayoutDirty(int32_t index);
+
+    //!Positions the entries from layoutDirtyFrom downward and parks the ones that do not fit, newer entries keep their position
+    void updateLayout();
+
+    //!Shows "+parkedCount more" at offset, or hides the summary if parkedCount is 0
+    void updateSummary(uint32_t parkedCount, float offset);
+
+    static void dropNotification(const std::shared_ptr<Notification> &status);
+
+    //!Pushes the notification as new ADD command, so it is shown again once the overlay is back
+    static void requeueNotification(std::shared_ptr<Notification> status);
+
+    OverlayElement *parent = nullptr;
+    OverlayStackId id      = OVERLAY_STACK_TOP_LEFT;
+    NotificationStore store;                          //!< visible notifications, oldest first
+    std::deque<std::shared_ptr<Notification>> queued; //!< waiting for a free spot, oldest first
+    GuiImage summaryBackground;
+    GuiText summaryText;
+    uint32_t summaryCount   = 0;    //!< number of parked notifications the summary shows, 0 if it is hidden
+    float summaryOffset     = 0.0f; //!< position of the newest parked entry, where the summary is shown
+    int32_t layoutDirtyFrom = -1;   //!< highest index that has to be positioned again, -1 if the layout is up to date
+};
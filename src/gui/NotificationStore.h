@@ -0,0 +1,95 @@
+#pragma once
+#include "Notification.h"
+#include <memory>
+#include <vector>
+
+//! Visible notifications of the overlay, oldest first.
+//! Every field is kept in its own contiguous array so the per frame loops only touch the data they need.
+//! Indices are only valid until the next call of add, removeAt or clear.
+class NotificationStore {
+public:
+    [[nodiscard]] uint32_t size() const {
+        return (uint32_t) items.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return items.empty();
+    }
+
+    void reserve(uint32_t count) {
+        items.reserve(count);
+        owners.reserve(count);
+        priorities.reserve(count);
+        heights.reserve(count);
+        positions.reserve(count);
+        parked.reserve(count);
+    }
+
+    //!Appends the notification as newest entry
+    //!\return index of the new entry
+    uint32_t add(std::shared_ptr<Notification> notification) {
+        items.push_back(notification.get());
+        priorities.push_back(notification->getPriority());
+        heights.push_back(notification->getHeight());
+        positions.push_back(0.0f);
+        parked.push_back(0);
+        owners.push_back(std::move(notification));
+        return size() - 1;
+    }
+
+    //!Removes the entry at index, the order of the remaining entries is kept
+    void removeAt(uint32_t index) {
+        items.erase(items.begin() + index);
+        owners.erase(owners.begin() + index);
+        priorities.erase(priorities.begin() + index);
+        heights.erase(heights.begin() + index);
+        positions.erase(positions.begin() + index);
+        parked.erase(parked.begin() + index);
+    }
+
+    //!Removes all entries for which shouldRemove(index) returns true in a single pass, the order of the remaining entries is kept.
+    //!shouldRemove is called once per entry in ascending order, with the index the entry had before the call.
+    //!\return number of removed entries
+    template<typename Func>
+    uint32_t removeIf(Func &&shouldRemove) {
+        uint32_t count = size();
+        uint32_t kept  = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (shouldRemove(i)) {
+                continue;
+            }
+            if (kept != i) {
+                items[kept]      = items[i];
+                owners[kept]     = std::move(owners[i]);
+                priorities[kept] = priorities[i];
+                heights[kept]    = heights[i];
+                positions[kept]  = positions[i];
+                parked[kept]     = parked[i];
+            }
+            kept++;
+        }
+        items.resize(kept);
+        owners.resize(kept);
+        priorities.resize(kept);
+        heights.resize(kept);
+        positions.resize(kept);
+        parked.resize(kept);
+        return count - kept;
+    }
+
+    void clear() {
+        items.clear();
+        owners.clear();
+        priorities.clear();
+        heights.clear();
+        positions.clear();
+        parked.clear();
+    }
+
+    std::vector<Notification *> items;                 //!< Raw pointers for the per frame loops
+    std::vector<std::shared_ptr<Notification>> owners; //!< Keeps the notifications alive while they are visible
+    std::vector<uint32_t> priorities;                  //!< Notification::getPriority() as of the last process()
+    std::vector<float> heights;                        //!< Cached Notification::getHeight(), only updated when the size has changed
+    std::vector<float> positions;                      //!< Vertical offset relative to the top of the overlay
+    std::vector<uint8_t> parked;                       //!< 1 if the entry does not fit on screen, it is neither processed, animated nor drawn
+};
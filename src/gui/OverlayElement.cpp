@@ -0,0 +1,278 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include "OverlayElement.h"
+#include <coreinit/time.h>
+
+//! TODO remove this!
+static int32_t screenwidth  = 1280;
+static int32_t screenheight = 720;
+
+OSTime OverlayElement::frameTime = 0;
+
+/**
+ * Constructor for the Object class.
+ */
+OverlayElement::OverlayElement() {
+    xoffset       = 0.0f;
+    yoffset       = 0.0f;
+    zoffset       = 0.0f;
+    width         = 0.0f;
+    height        = 0.0f;
+    alpha         = 1.0f;
+    scaleX        = 1.0f;
+    scaleY        = 1.0f;
+    scaleZ        = 1.0f;
+    parentElement = nullptr;
+    visible       = true;
+    yoffsetDyn    = 0;
+    xoffsetDyn    = 0;
+    alphaDyn      = -1;
+    scaleDyn      = 1;
+    effects       = EFFECT_NONE;
+    effectTarget  = 0;
+    angle         = 0.0f;
+    angleDyn      = 0;
+
+    // default alignment - align to top left
+    alignment = (ALIGN_CENTERED);
+}
+
+/**
+ * Get the left position of the element.
+ * @see SetLeft()
+ * @return Left position in pixel.
+ */
+float OverlayElement::getLeft() {
+    return getWorldTransform().left;
+}
+
+/**
+ * Get the top position of the element.
+ * @see SetTop()
+ * @return Top position in pixel.
+ */
+float OverlayElement::getTop() {
+    return getWorldTransform().top;
+}
+
+/**
+ * Recomputes the absolute values of the element from the parent's cached values.
+ * The parent is updated first if necessary, so each element is computed once per change instead of per call.
+ */
+void OverlayElement::updateWorldTransform() {
+    float pWidth   = 0.0f;
+    float pHeight  = 0.0f;
+    float pLeft    = 0.0f;
+    float pTop     = 0.0f;
+    float pCenterX = 0.0f;
+    float pCenterY = 0.0f;
+    float pScaleX  = 1.0f;
+    float pScaleY  = 1.0f;
+
+    WorldTransform w;
+    w.depth  = zoffset;
+    w.scale  = 0.5f * (scaleX + scaleY) * scaleDyn;
+    w.scaleX = scaleX * scaleDyn;
+    w.scaleY = scaleY * scaleDyn;
+    w.scaleZ = scaleZ;
+    w.alpha  = (alphaDyn >= 0) ? alphaDyn : alpha;
+    w.angle  = angle + angleDyn;
+
+    if (parentElement) {
+        const WorldTransform &p = parentElement->getWorldTransform();
+
+        pWidth   = parentElement->getWidth();
+        pHeight  = parentElement->getHeight();
+        pLeft    = p.left;
+        pTop     = p.top;
+        pCenterX = p.centerX;
+        pCenterY = p.centerY;
+        pScaleX  = p.scaleX;
+        pScaleY  = p.scaleY;
+
+        w.depth += p.depth;
+        w.scale *= p.scale;
+        w.scaleX *= p.scaleX;
+        w.scaleY *= p.scaleY;
+        w.scaleZ *= p.scaleZ;
+        w.alpha *= p.alpha;
+        w.angle += p.angle;
+    }
+
+    float curWidth  = getWidth();
+    float curHeight = getHeight();
+
+    w.left = pLeft + xoffsetDyn;
+    if (alignment & ALIGN_CENTER) {
+        w.left += pWidth * 0.5f * pScaleX - curWidth * 0.5f * w.scaleX;
+    } else if (alignment & ALIGN_RIGHT) {
+        w.left += pWidth * pScaleX - curWidth * w.scaleX;
+    }
+    w.left += xoffset;
+
+    w.top = pTop + yoffsetDyn;
+    if (alignment & ALIGN_MIDDLE) {
+        w.top += pHeight * 0.5f * pScaleY - curHeight * 0.5f * w.scaleY;
+    } else if (alignment & ALIGN_BOTTOM) {
+        w.top += pHeight * pScaleY - curHeight * w.scaleY;
+    }
+    w.top += yoffset;
+
+    w.centerX = pCenterX + xoffset + xoffsetDyn;
+    if (alignment & ALIGN_LEFT) {
+        w.centerX -= pWidth * 0.5f * pScaleX - curWidth * 0.5f * w.scaleX;
+    } else if (alignment & ALIGN_RIGHT) {
+        w.centerX += pWidth * 0.5f * pScaleX - curWidth * 0.5f * w.scaleX;
+    }
+
+    w.centerY = pCenterY + yoffset + yoffsetDyn;
+    if (alignment & ALIGN_TOP) {
+        w.centerY += pHeight * 0.5f * pScaleY - curHeight * 0.5f * w.scaleY;
+    } else if (alignment & ALIGN_BOTTOM) {
+        w.centerY -= pHeight * 0.5f * pScaleY - curHeight * 0.5f * w.scaleY;
+    }
+
+    world          = w;
+    transformDirty = false;
+}
+
+void OverlayElement::setEffect(int32_t eff, float durationInSeconds, int32_t target, TweenEasing easing) {
+    float from = 0.0f;
+    float to   = 0.0f;
+    if (eff & EFFECT_SLIDE_IN) {
+        // these calculations overcompensate a little
+        if (eff & EFFECT_SLIDE_TOP) {
+            if (eff & EFFECT_SLIDE_FROM) {
+                yoffsetDyn = -getHeight() * scaleY;
+            } else {
+                yoffsetDyn = -screenheight;
+            }
+            from = yoffsetDyn;
+        } else if (eff & EFFECT_SLIDE_LEFT) {
+            if (eff & EFFECT_SLIDE_FROM) {
+                xoffsetDyn = -getWidth() * scaleX;
+            } else {
+                xoffsetDyn = -screenwidth;
+            }
+            from = xoffsetDyn;
+        } else if (eff & EFFECT_SLIDE_BOTTOM) {
+            if (eff & EFFECT_SLIDE_FROM) {
+                yoffsetDyn = getHeight() * scaleY;
+            } else {
+                yoffsetDyn = screenheight;
+            }
+            from = yoffsetDyn;
+        } else if (eff & EFFECT_SLIDE_RIGHT) {
+            if (eff & EFFECT_SLIDE_FROM) {
+                xoffsetDyn = getWidth() * scaleX;
+            } else {
+                xoffsetDyn = screenwidth;
+            }
+            from = xoffsetDyn;
+        }
+    } else if (eff & (EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM)) {
+        // EFFECT_SLIDE_FROM stops as soon as the element is out of sight
+        if (eff & EFFECT_SLIDE_LEFT) {
+            from = xoffsetDyn;
+            to   = (eff & EFFECT_SLIDE_FROM) ? -(getWidth() + xoffset) : -screenwidth;
+        } else if (eff & EFFECT_SLIDE_RIGHT) {
+            from = xoffsetDyn;
+            to   = (eff & EFFECT_SLIDE_FROM) ? getWidth() * scaleX - xoffset : screenwidth;
+        } else if (eff & EFFECT_SLIDE_TOP) {
+            from = yoffsetDyn;
+            to   = (eff & EFFECT_SLIDE_FROM) ? -getHeight() : -screenheight;
+        } else if (eff & EFFECT_SLIDE_BOTTOM) {
+            from = yoffsetDyn;
+            to   = (eff & EFFECT_SLIDE_FROM) ? getHeight() : screenheight;
+        }
+    } else if (eff & EFFECT_FADE) {
+        alphaDyn = (target > 0) ? 0 : alpha;
+        from     = alphaDyn;
+        to       = (target > 0) ? alpha : 0;
+    } else if (eff & EFFECT_SCALE) {
+        from = scaleDyn;
+        to   = target * 0.01f;
+    }
+    effectTween.start(from, to, durationInSeconds, easing, frameTime);
+    effects |= eff;
+    effectTarget = target;
+    invalidateTransform();
+}
+
+void OverlayElement::resetEffects() {
+    yoffsetDyn   = 0;
+    xoffsetDyn   = 0;
+    alphaDyn     = -1;
+    scaleDyn     = 1;
+    angleDyn     = 0;
+    effects      = EFFECT_NONE;
+    effectTarget = 0;
+    invalidateTransform();
+}
+
+void OverlayElement::updateEffects() {
+    if (!this->isVisible() && parentElement) {
+        return;
+    }
+
+    if (effects == EFFECT_NONE) {
+        return;
+    }
+    // Every effect changes at least one of the dynamic values
+    invalidateTransform();
+
+    // One evaluation per frame, the result only depends on the frame time and not on the frame rate
+    bool finished = false;
+    if (effects & (EFFECT_SLIDE_IN | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM)) {
+        float value = effectTween.evaluate(frameTime, finished);
+        if (effects & (EFFECT_SLIDE_LEFT | EFFECT_SLIDE_RIGHT)) {
+            xoffsetDyn = value;
+        } else if (effects & (EFFECT_SLIDE_TOP | EFFECT_SLIDE_BOTTOM)) {
+            yoffsetDyn = value;
+        }
+    } else if (effects & EFFECT_FADE) {
+        alphaDyn = effectTween.evaluate(frameTime, finished);
+    } else if (effects & EFFECT_SCALE) {
+        scaleDyn = effectTween.evaluate(frameTime, finished);
+    } else if (effects & EFFECT_SHAKE) {
+        // angle, x and y offset of the shake steps
+        static constexpr float shakeSteps[5][3] = {
+                {0.0f, 0.0f, 0.0f},
+                {-0.3f, -1.0f, -2.0f},
+                {0.3f, -1.0f, 0.0f},
+                {0.0f, 0.0f, 1.0f},
+                {-0.3f, 1.0f, -1.0f},
+        };
+        float elapsed = effectTween.getElapsed(frameTime);
+        finished      = elapsed >= effectTween.getDuration();
+
+        // The pattern repeats every 10 steps of 1/60s
+        uint32_t step  = (uint32_t) (elapsed * 60.0f) % 10;
+        uint32_t index = (finished || step < 3) ? 0 : (step - 1) / 2;
+        angleDyn       = shakeSteps[index][0];
+        xoffsetDyn     = shakeSteps[index][1];
+        yoffsetDyn     = shakeSteps[index][2];
+        if (finished) {
+            effectTarget = 0;
+        }
+    }
+
+    if (finished) {
+        effects = EFFECT_NONE; // shut off effect
+        onEffectFinished();
+    }
+}
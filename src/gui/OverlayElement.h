@@ -0,0 +1,373 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Tween.h"
+#include "shaders/gx2_ext.h"
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <wchar.h>
+#pragma GCC diagnostic ignored "-Wvolatile"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+
+enum {
+    EFFECT_NONE             = 0x00,
+    EFFECT_SLIDE_TOP        = 0x01,
+    EFFECT_SLIDE_BOTTOM     = 0x02,
+    EFFECT_SLIDE_RIGHT      = 0x04,
+    EFFECT_SLIDE_LEFT       = 0x08,
+    EFFECT_SLIDE_IN         = 0x10,
+    EFFECT_SLIDE_OUT        = 0x20,
+    EFFECT_SLIDE_FROM       = 0x40,
+    EFFECT_FADE             = 0x80,
+    EFFECT_SCALE            = 0x100,
+    EFFECT_COLOR_TRANSITION = 0x200,
+    EFFECT_SHAKE            = 0x400,
+};
+
+enum {
+    ALIGN_LEFT       = 0x01,
+    ALIGN_CENTER     = 0x02,
+    ALIGN_RIGHT      = 0x04,
+    ALIGN_TOP        = 0x10,
+    ALIGN_MIDDLE     = 0x20,
+    ALIGN_BOTTOM     = 0x40,
+    ALIGN_TOP_LEFT   = ALIGN_LEFT | ALIGN_TOP,
+    ALIGN_TOP_CENTER = ALIGN_CENTER | ALIGN_TOP,
+    ALIGN_TOP_RIGHT  = ALIGN_RIGHT | ALIGN_TOP,
+    ALIGN_CENTERED   = ALIGN_CENTER | ALIGN_MIDDLE,
+};
+
+//!Base of everything that is drawn by the overlay: size, transform, alpha and effects.
+//!Input handling is left to GuiElement, so elements of the overlay stay small.
+class OverlayElement {
+public:
+    //!Constructor
+    OverlayElement();
+
+    //!Destructor
+    virtual ~OverlayElement() = default;
+
+    //!Set the element's parent
+    //!\param e Pointer to parent element
+    virtual void setParent(OverlayElement *e) {
+        parentElement = e;
+        invalidateTransform();
+    }
+
+    //!Gets the element's parent
+    //!\return Pointer to parent element
+    virtual OverlayElement *getParent() {
+        return parentElement;
+    }
+
+    //!Gets the current leftmost coordinate of the element
+    //!Considers horizontal alignment, x offset, width, and parent element's GetLeft() / GetWidth() values
+    //!\return left coordinate
+    virtual float getLeft();
+
+    //!Gets the current topmost coordinate of the element
+    //!Considers vertical alignment, y offset, height, and parent element's GetTop() / GetHeight() values
+    //!\return top coordinate
+    virtual float getTop();
+
+    //!Gets the current Z coordinate of the element
+    //!\return Z coordinate
+    virtual float getDepth() {
+        return getWorldTransform().depth;
+    }
+
+    //!Gets the current center of the element, relative to the center of the screen
+    //!Considers alignment, offsets, and the parent element's getCenterX() / getWidth() / getScaleX() values
+    virtual float getCenterX(void) {
+        return getWorldTransform().centerX;
+    }
+
+    //!Gets the current center of the element, relative to the center of the screen
+    //!Considers alignment, offsets, and the parent element's getCenterY() / getHeight() / getScaleY() values
+    virtual float getCenterY(void) {
+        return getWorldTransform().centerY;
+    }
+
+    //!Gets elements xoffset
+    virtual float getOffsetX() {
+        return xoffset;
+    }
+
+    //!Gets elements yoffset
+    virtual float getOffsetY() {
+        return yoffset;
+    }
+
+    //!Gets the current width of the element. Does not currently consider the scale
+    //!\return width
+    virtual float getWidth() {
+        return width;
+    };
+
+    //!Gets the height of the element. Does not currently consider the scale
+    //!\return height
+    virtual float getHeight() {
+        return height;
+    }
+
+    //!Sets the size (width/height) of the element
+    //!\param w Width of element
+    //!\param h Height of element
+    virtual void setSize(float w, float h) {
+        width  = w;
+        height = h;
+        invalidateTransform();
+    }
+
+    //!Sets the element's visibility
+    //!\param v Visibility (true = visible)
+    virtual void setVisible(bool v) {
+        visible = v;
+    }
+
+    //!Checks whether or not the element is visible
+    //!\return true if visible, false otherwise
+    virtual bool isVisible() const {
+        return visible;
+    }
+
+    //!Sets the element's alpha value
+    //!\param a alpha value
+    virtual void setAlpha(float a) {
+        alpha = a;
+        invalidateTransform();
+    }
+
+    //!Gets the element's alpha value
+    //!Considers alpha, alphaDyn, and the parent element's getAlpha() value
+    //!\return alpha
+    virtual float getAlpha() {
+        return getWorldTransform().alpha;
+    }
+
+    //!Sets the element's scale
+    //!\param s scale (1 is 100%)
+    virtual void setScale(float s) {
+        scaleX = s;
+        scaleY = s;
+        scaleZ = s;
+        invalidateTransform();
+    }
+
+    //!Sets the element's scale
+    //!\param s scale (1 is 100%)
+    virtual void setScaleX(float s) {
+        scaleX = s;
+        invalidateTransform();
+    }
+
+    //!Sets the element's scale
+    //!\param s scale (1 is 100%)
+    virtual void setScaleY(float s) {
+        scaleY = s;
+        invalidateTransform();
+    }
+
+    //!Sets the element's scale
+    //!\param s scale (1 is 100%)
+    virtual void setScaleZ(float s) {
+        scaleZ = s;
+        invalidateTransform();
+    }
+
+    //!Gets the element's current scale
+    //!Considers scale, scaleDyn, and the parent element's getScale() value
+    virtual float getScale() {
+        return getWorldTransform().scale;
+    }
+
+    //!Gets the element's current scale
+    //!Considers scale, scaleDyn, and the parent element's getScale() value
+    virtual float getScaleX() {
+        return getWorldTransform().scaleX;
+    }
+
+    //!Gets the element's current scale
+    //!Considers scale, scaleDyn, and the parent element's getScale() value
+    virtual float getScaleY() {
+        return getWorldTransform().scaleY;
+    }
+
+    //!Gets the element's current scale
+    //!Considers scale, scaleDyn, and the parent element's getScale() value
+    virtual float getScaleZ() {
+        return getWorldTransform().scaleZ;
+    }
+
+    //!Set an effect for the element, it is animated based on the frame time (see setFrameTime)
+    //!\param e Effect to enable
+    //!\param durationInSeconds Duration of the effect
+    //!\param t Target amount of the effect (usage varies on effect: 0 fades out, > 0 fades in; scale in percent)
+    //!\param easing Easing curve of the effect
+    virtual void setEffect(int32_t e, float durationInSeconds, int32_t t = 0, TweenEasing easing = TWEEN_EASE_LINEAR);
+
+    //!Reset all applied effects
+    virtual void resetEffects();
+
+    //!Gets the current element effects
+    //!\return element effects
+    virtual int32_t getEffect() const {
+        return effects;
+    }
+
+    //!\return true if element animation is on going
+    virtual bool isAnimated() const {
+        return (parentElement != 0) && (getEffect() > 0);
+    }
+
+    //!Sets the element's position
+    //!\param x X coordinate
+    //!\param y Y coordinate
+    virtual void setPosition(float x, float y) {
+        xoffset = x;
+        yoffset = y;
+        invalidateTransform();
+    }
+
+    //!Sets the element's position
+    //!\param x X coordinate
+    //!\param y Y coordinate
+    //!\param z Z coordinate
+    virtual void setPosition(float x, float y, float z) {
+        xoffset = x;
+        yoffset = y;
+        zoffset = z;
+        invalidateTransform();
+    }
+
+    //!Sets the element's alignment respective to its parent element
+    //!Bitwise ALIGN_LEFT | ALIGN_RIGHT | ALIGN_CENTRE, ALIGN_TOP, ALIGN_BOTTOM, ALIGN_MIDDLE)
+    //!\param align Alignment
+    virtual void setAlignment(int32_t a) {
+        alignment = a;
+        invalidateTransform();
+    }
+
+    //!Gets the element's alignment
+    virtual int32_t getAlignment() const {
+        return alignment;
+    }
+
+    //!Angle of the object
+    virtual void setAngle(float a) {
+        angle = a;
+        invalidateTransform();
+    }
+
+    //!Angle of the object
+    virtual float getAngle() {
+        return getWorldTransform().angle;
+    }
+
+    //!Marks the cached absolute position, scale, alpha and angle as outdated.
+    //!Has to be called whenever a value they depend on is changed, containers forward it to their children.
+    virtual void invalidateTransform() {
+        transformDirty = true;
+    }
+
+    //!Called constantly to redraw the element
+    virtual void draw([[maybe_unused]] bool SRGBConversion) {}
+
+    //!Called constantly to process stuff in the element
+    virtual void process() {}
+
+    //!Updates the element's effects (dynamic values)
+    //!Called by Draw(), used for animation purposes
+    virtual void updateEffects();
+
+    //!Sets the time all effects are evaluated at, has to be called once per frame before updateEffects()
+    static void setFrameTime(OSTime now) {
+        frameTime = now;
+    }
+
+    //!\return the time set by setFrameTime
+    static OSTime getFrameTime() {
+        return frameTime;
+    }
+
+protected:
+    //!Absolute values of the element, derived from the local values and the parent chain
+    typedef struct WorldTransform {
+        float left;
+        float top;
+        float centerX;
+        float centerY;
+        float depth;
+        float scale;
+        float scaleX;
+        float scaleY;
+        float scaleZ;
+        float alpha;
+        float angle;
+    } WorldTransform;
+
+    //!\return the cached world transform, recomputed first if it has been invalidated
+    const WorldTransform &getWorldTransform() {
+        if (transformDirty) {
+            updateWorldTransform();
+        }
+        return world;
+    }
+
+    void updateWorldTransform();
+
+    //!Called by updateEffects() once the current effect has finished
+    virtual void onEffectFinished() {}
+
+    bool visible;                  //!< Visibility of the element. If false, Draw() is skipped
+    bool transformDirty = true;    //!< world has to be recomputed before it is used
+    int32_t alignment;             //!< Horizontal element alignment, respective to parent element
+    float width;                   //!< Element width
+    float height;                  //!< Element height
+    float xoffset;                 //!< Element X offset
+    float yoffset;                 //!< Element Y offset
+    float zoffset;                 //!< Element Z offset
+    float alpha;                   //!< Element alpha value (0-255)
+    float angle;                   //!< Angle of the object (0-360)
+    float scaleX;                  //!< Element scale (1 = 100%)
+    float scaleY;                  //!< Element scale (1 = 100%)
+    float scaleZ;                  //!< Element scale (1 = 100%)
+    OverlayElement *parentElement; //!< Parent element
+    WorldTransform world = {};     //!< Cached absolute values, see getWorldTransform
+
+    //! TODO: Move me to some Animator class
+    float xoffsetDyn; //!< Element X offset, dynamic (added to xoffset value for animation effects)
+    float yoffsetDyn; //!< Element Y offset, dynamic (added to yoffset value for animation effects)
+    float alphaDyn;   //!< Element alpha, dynamic (multiplied by alpha value for blending/fading effects)
+    float scaleDyn;   //!< Element scale, dynamic (multiplied by alpha value for blending/fading effects)
+    float angleDyn;
+    int32_t effects;      //!< Currently enabled effect(s). 0 when no effects are enabled
+    int32_t effectTarget; //!< Effect target amount. Used by different effects for different purposes
+    Tween effectTween;    //!< Animates the dynamic value of the current effect
+
+    static OSTime frameTime; //!< Time of the current frame, sampled once per frame
+};
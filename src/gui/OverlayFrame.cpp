@@ -1,72 +1,90 @@
 #include "OverlayFrame.h"
+#include "retain_vars.hpp"
+
+OverlayFrame::OverlayFrame(int w, int h) : GuiFrame(w, h) {
+    for (int32_t i = 0; i < OVERLAY_STACK_COUNT; i++) {
+        stacks[i].init(this, (OverlayStackId) i);
+    }
+}
 
 void OverlayFrame::addNotification(std::shared_ptr<Notification> status) {
-    status->setParent(this);
-    append(status.get());
-    status->setAlignment(ALIGN_TOP_LEFT);
-    status->setEffect(EFFECT_FADE, 55, 255);
-    {
-        std::lock_guard<std::mutex> lock(gNotificationListMutex);
-        list.push_front(std::move(status));
+    auto stack = status->getStack();
+    if (stack >= OVERLAY_STACK_COUNT) {
+        stack = OVERLAY_STACK_TOP_LEFT;
     }
+    stacks[stack].addNotification(std::move(status));
 }
 
-void OverlayFrame::OnFadeOutFinished(GuiElement *element) {
-    auto *item = dynamic_cast<Notification *>(element);
-    if (item) {
-        item->mInternalStatus = NOTIFICATION_STATUS_REQUESTED_EXIT;
-    } else {
-        DEBUG_FUNCTION_LINE_ERR("Failed to fade out item: dynamic cast failed");
+void OverlayFrame::clearElements() {
+    for (auto &stack : stacks) {
+        stack.clear();
     }
+    gOverlayState.fetch_and(~OVERLAY_STATE_ACTIVE);
 }
 
-void OverlayFrame::OnShakeFinished(GuiElement *element) {
-    auto *item = dynamic_cast<Notification *>(element);
-    if (item) {
-        item->mInternalStatus = NOTIFICATION_STATUS_WAIT;
+void OverlayFrame::process() {
+    GuiElement::process();
+
+    bool empty = true;
+    for (auto &stack : stacks) {
+        // Every stack has its own layout, a growing progress notification does not move the other stacks.
+        stack.process();
+        empty = empty && stack.empty();
     }
+    if (empty) {
+        gOverlayState.fetch_and(~OVERLAY_STATE_ACTIVE);
+    }
+    updateDrawBounds();
 }
 
-void OverlayFrame::clearElements() {
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
-    for (auto &element : list) {
-        remove(element.get());
+void OverlayFrame::updateEffects() {
+    GuiElement::updateEffects();
+
+    for (auto &stack : stacks) {
+        stack.updateEffects();
     }
-    list.clear();
 }
 
-void OverlayFrame::process() {
-    GuiFrame::process();
+void OverlayFrame::draw(bool SRGBConversion) {
+    if (!this->isVisible() && parentElement) {
+        return;
+    }
 
-    std::lock_guard<std::mutex> lock(gNotificationListMutex);
+    for (auto &stack : stacks) {
+        stack.draw(SRGBConversion);
+    }
+}
+
+void OverlayFrame::invalidateTransform() {
+    if (transformDirty) {
+        return;
+    }
+    GuiFrame::invalidateTransform();
+
+    for (auto &stack : stacks) {
+        stack.invalidateTransform();
+    }
+}
 
-    float offset = -25.0f;
-    for (auto &item : list) {
-        item->process();
-        item->setPosition(25, offset);
-        offset -= (item->getHeight() + 10.0f);
-        if (item->mInternalStatus == NOTIFICATION_STATUS_REQUESTED_FADE_OUT_AND_EXIT) {
-            item->resetEffects();
-            item->setEffect(EFFECT_SLIDE_LEFT | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM, 30);
-            item->effectFinished.connect(this, &OverlayFrame::OnFadeOutFinished);
-            item->finishFunction();
-            item->mInternalStatus = NOTIFICATION_STATUS_EFFECT;
-        } else if (item->mInternalStatus == NOTIFICATION_STATUS_REQUESTED_SHAKE) {
-            item->resetEffects();
-            // shake for fixed duration, even if we drop frames
-            item->setEffect(EFFECT_SHAKE, 0, (int32_t) (item->mShakeDurationInSeconds * 1000));
-            item->effectFinished.connect(this, &OverlayFrame::OnShakeFinished);
-            item->mInternalStatus = NOTIFICATION_STATUS_EFFECT;
-        }
+void OverlayFrame::updateDrawBounds() {
+    drawBoundsEmpty = true;
+    drawBounds      = {};
+    for (auto &stack : stacks) {
+        stack.addDrawBounds(drawBounds, drawBoundsEmpty, getWidth(), getHeight());
+    }
+    if (!drawBoundsEmpty) {
+        drawBounds.left   = std::max(drawBounds.left, 0.0f);
+        drawBounds.top    = std::max(drawBounds.top, 0.0f);
+        drawBounds.right  = std::min(drawBounds.right, getWidth());
+        drawBounds.bottom = std::min(drawBounds.bottom, getHeight());
+        drawBoundsEmpty   = drawBounds.top >= drawBounds.bottom || drawBounds.left >= drawBounds.right;
     }
-    auto oit = list.before_begin(), it = std::next(oit);
-    while (it != list.end()) {
-        if ((*it)->mInternalStatus == NOTIFICATION_STATUS_REQUESTED_EXIT) {
-            (*it)->callDeleteCallback();
-            remove((*it).get());
-            list.erase_after(oit);
-            break;
-        }
-        oit = it++;
+}
+
+bool OverlayFrame::getDrawBounds(OverlayBounds &bounds) const {
+    if (drawBoundsEmpty) {
+        return false;
     }
+    bounds = drawBounds;
+    return true;
 }
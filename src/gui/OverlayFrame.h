@@ -1,28 +1,36 @@
 #pragma once
 #include "GuiFrame.h"
-#include "Notification.h"
-#include "sigslot.h"
+#include "NotificationStack.h"
 #include "utils/logger.h"
 #include "utils/utils.h"
-#include <forward_list>
 
-class OverlayFrame : public GuiFrame, public sigslot::has_slots<> {
+class OverlayFrame final : public GuiFrame {
 
 public:
-    OverlayFrame(int w, int h) : GuiFrame(w, h) {
-    }
+    OverlayFrame(int w, int h);
     ~OverlayFrame() override = default;
 
+    //!Shows the notification in the stack selected via Notification::setStack, every stack applies its own limit
     void addNotification(std::shared_ptr<Notification> status);
 
-    void OnFadeOutFinished(GuiElement *element);
+    void process() override;
 
-    void OnShakeFinished(GuiElement *element);
+    void updateEffects() override;
 
-    void process() override;
+    void draw(bool SRGBConversion) override;
+
+    void invalidateTransform() override;
 
     void clearElements();
 
+    //!Gets the area covered by the notifications as of the last process() call
+    //!\return false if nothing needs to be drawn
+    bool getDrawBounds(OverlayBounds &bounds) const;
+
 private:
-    std::forward_list<std::shared_ptr<Notification>> list;
+    void updateDrawBounds();
+
+    NotificationStack stacks[OVERLAY_STACK_COUNT];
+    OverlayBounds drawBounds = {};
+    bool drawBoundsEmpty     = true;
 };
@@ -23,6 +23,7 @@
 #include "SchriftGX2.h"
 #include "schrift.h"
 #include "shaders/Texture2DShader.h"
+#include "utils/Statistics.h"
 #include "utils/logger.h"
 
 using namespace std;
@@ -182,14 +183,17 @@ void SchriftGX2::unloadFont() {
 * @return A pointer to the allocated font structure.
 */
 ftgxCharData *SchriftGX2::cacheGlyphData(wchar_t charCode, int16_t pixelSize) {
+    ScopedStatisticTimer timer(STATISTIC_TIMER_CACHE_GLYPH);
     std::lock_guard<std::mutex> lock(fontDataMutex);
     auto itr = fontData.find(pixelSize);
     if (itr != fontData.end()) {
         auto itr2 = itr->second.ftgxCharMap.find(charCode);
         if (itr2 != itr->second.ftgxCharMap.end()) {
+            StatisticsAddGlyphCacheLookup(true);
             return &itr2->second;
         }
     }
+    StatisticsAddGlyphCacheLookup(false);
     //!Cache ascender and decender as well
     ftGX2Data *ftData = &fontData[pixelSize];
 
@@ -0,0 +1,76 @@
+#pragma once
+#include <coreinit/time.h>
+
+typedef enum {
+    TWEEN_EASE_LINEAR,
+    TWEEN_EASE_IN_QUAD,
+    TWEEN_EASE_OUT_QUAD,
+    TWEEN_EASE_IN_OUT_QUAD,
+    TWEEN_EASE_OUT_CUBIC,
+} TweenEasing;
+
+//!\return the duration in seconds
+static inline float TicksToSeconds(OSTime ticks) {
+    return (float) OSTicksToMicroseconds(ticks) * 0.000001f;
+}
+
+//!Maps the linear progress t (0-1) to the eased progress
+static inline float TweenEase(TweenEasing easing, float t) {
+    switch (easing) {
+        case TWEEN_EASE_IN_QUAD:
+            return t * t;
+        case TWEEN_EASE_OUT_QUAD:
+            return t * (2.0f - t);
+        case TWEEN_EASE_IN_OUT_QUAD:
+            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case TWEEN_EASE_OUT_CUBIC: {
+            float f = t - 1.0f;
+            return f * f * f + 1.0f;
+        }
+        case TWEEN_EASE_LINEAR:
+        default:
+            return t;
+    }
+}
+
+//!Animates a value over a fixed time, independent of the frame rate
+class Tween {
+public:
+    void start(float from, float to, float durationInSeconds, TweenEasing easing, OSTime now) {
+        mFrom              = from;
+        mTo                = to;
+        mDurationInSeconds = durationInSeconds;
+        mEasing            = easing;
+        mStart             = now;
+    }
+
+    //!\return seconds since start
+    [[nodiscard]] float getElapsed(OSTime now) const {
+        return TicksToSeconds(now - mStart);
+    }
+
+    [[nodiscard]] float getDuration() const {
+        return mDurationInSeconds;
+    }
+
+    //!Evaluates the value at now, the end value is returned once the duration has passed
+    //!\param finished is set to true if the duration has passed
+    [[nodiscard]] float evaluate(OSTime now, bool &finished) const {
+        float t  = mDurationInSeconds > 0.0f ? getElapsed(now) / mDurationInSeconds : 1.0f;
+        finished = t >= 1.0f;
+        if (finished) {
+            return mTo;
+        }
+        if (t < 0.0f) {
+            t = 0.0f;
+        }
+        return mFrom + (mTo - mFrom) * TweenEase(mEasing, t);
+    }
+
+private:
+    OSTime mStart            = 0;
+    float mFrom              = 0.0f;
+    float mTo                = 0.0f;
+    float mDurationInSeconds = 0.0f;
+    TweenEasing mEasing      = TWEEN_EASE_LINEAR;
+};
@@ -1,9 +1,12 @@
+#include "callback_dispatcher.h"
 #include "export.h"
 #include "function_patches.h"
 #include "retain_vars.hpp"
 #include "shaders/ColorShader.h"
 #include "shaders/Texture2DShader.h"
+#include "utils/Statistics.h"
 #include "utils/logger.h"
+#include "utils/utils.h"
 #include "version.h"
 #include <coreinit/memory.h>
 #include <function_patcher/function_patching.h>
@@ -43,6 +46,16 @@ WUMS_INITIALIZE() {
         DEBUG_FUNCTION_LINE_VERBOSE("Allocated %d bytes for gContextState", sizeof(GX2ContextState));
     }
 
+    OSInitEvent(&gOverlayReadyEvent, FALSE, OS_EVENT_MODE_MANUAL);
+
+    if (!InitAllocationPools()) {
+        DEBUG_FUNCTION_LINE_ERR("Failed to init allocation pools, notifications will be allocated from the heap");
+    }
+
+    if (!gTVOverlayGPUTimer.init() || !gDRCOverlayGPUTimer.init()) {
+        DEBUG_FUNCTION_LINE_ERR("Failed to init GPU timers, overlay GPU timing won't be available");
+    }
+
     void *font    = nullptr;
     uint32_t size = 0;
     if (OSGetSharedData(OS_SHAREDDATATYPE_FONT_STANDARD, 0, &font, &size) && font && size > 0) {
@@ -62,14 +75,23 @@ WUMS_APPLICATION_STARTS() {
     initLogging();
     OSReport("Running NotificationModule " VERSION VERSION_EXTRA "\n");
     gDrawReady = false;
+    gTVOverlayGPUTimer.reset();
+    gDRCOverlayGPUTimer.reset();
+    StatisticsReset();
+    if (!StartCallbackDispatcher()) {
+        DEBUG_FUNCTION_LINE_ERR("Failed to start callback dispatcher, finish callbacks will be called directly");
+    }
 }
 
 WUMS_APPLICATION_ENDS() {
     gDrawReady = false;
+    OSResetEvent(&gOverlayReadyEvent);
     if (gOverlayFrame) {
         gOverlayFrame->clearElements();
     }
     ExportCleanUp();
+    // Runs the finish callbacks of all notifications that have been removed above
+    StopCallbackDispatcher();
     if (gFontSystem) {
         gFontSystem->unloadFont();
     }
@@ -82,4 +104,7 @@ WUMS_DEINITIALIZE() {
     delete gOverlayFrame;
     delete gFontSystem;
     MEMFreeToMappedMemory(gContextState);
+    gTVOverlayGPUTimer.destroy();
+    gDRCOverlayGPUTimer.destroy();
+    DestroyAllocationPools();
 }
\ No newline at end of file
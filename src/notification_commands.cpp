@@ -0,0 +1,310 @@
+#include "notification_commands.h"
+#include "retain_vars.hpp"
+#include "utils/LockFreeRing.h"
+#include "utils/Statistics.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#define NOTIFICATION_COMMAND_QUEUE_SIZE 512
+
+#define PENDING_UPDATE_TEXT_COLOR       (1 << 0)
+#define PENDING_UPDATE_BACKGROUND_COLOR (1 << 1)
+
+//! Latest not yet applied updates of a dynamic notification, indexed by the slot index of its handle.
+//! At most one NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE per entry is in the queue, so high-rate updates
+//! only replace the pending values instead of filling the queue.
+//! Slots are reused, so every access is checked against the full handle (including the generation).
+typedef struct PendingNotificationUpdate {
+    std::atomic<uint32_t> handle; //!< handle the entry currently belongs to, set by ReserveNotificationHandle
+    std::atomic<uint32_t> queued; //!< handle a NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE is in the queue for, 0 if there is none
+    std::atomic<uint32_t> flags;  //!< PENDING_UPDATE_* of the colors that have been set
+    std::atomic<char *> text;     //!< nullptr if there is no pending text
+    std::atomic<uint32_t> textColor;
+    std::atomic<uint32_t> backgroundColor;
+} PendingNotificationUpdate;
+
+static LockFreeRing<NotificationCommand, NOTIFICATION_COMMAND_QUEUE_SIZE> sCommandQueue;
+static PendingNotificationUpdate sPendingUpdates[NOTIFICATION_HANDLE_TABLE_SIZE];
+
+static inline uint32_t PackColor(GX2Color color) {
+    return ((uint32_t) color.r << 24) | ((uint32_t) color.g << 16) | ((uint32_t) color.b << 8) | color.a;
+}
+
+static inline GX2Color UnpackColor(uint32_t color) {
+    return (GX2Color){(uint8_t) (color >> 24), (uint8_t) (color >> 16), (uint8_t) (color >> 8), (uint8_t) color};
+}
+
+static inline PendingNotificationUpdate &GetPendingUpdate(uint32_t handle) {
+    return sPendingUpdates[handle & 0xFFFF];
+}
+
+static void FreeNotificationCommand(NotificationCommand &command) {
+    command.notification.reset();
+}
+
+uint32_t PushNotificationCommands(NotificationCommand *commands, uint32_t count) {
+    uint32_t pushed = 0;
+    while (pushed < count && sCommandQueue.push(std::move(commands[pushed]))) {
+        pushed++;
+    }
+    if (pushed > 0) {
+        // Set the flag after publishing the commands, ProcessNotificationCommands clears it before draining.
+        gOverlayState.fetch_or(OVERLAY_STATE_QUEUE_PENDING);
+    }
+    return pushed;
+}
+
+bool PushNotificationCommand(NotificationCommand &command) {
+    if (PushNotificationCommands(&command, 1) != 1) {
+        FreeNotificationCommand(command);
+        return false;
+    }
+    return true;
+}
+
+static inline bool IsPendingUpdateOwner(uint32_t handle) {
+    return GetPendingUpdate(handle).handle.load(std::memory_order_acquire) == handle;
+}
+
+static bool QueuePendingUpdate(uint32_t handle) {
+    auto &pending     = GetPendingUpdate(handle);
+    uint32_t expected = 0;
+    while (!pending.queued.compare_exchange_weak(expected, handle, std::memory_order_acq_rel)) {
+        if (expected == handle) {
+            // Will be picked up by the command that is already in the queue.
+            return true;
+        }
+        // The marker of a stale handle (expected != 0) would be cleared once its command is dropped, don't wait for it.
+    }
+    NotificationCommand command;
+    command.type   = NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE;
+    command.handle = handle;
+    if (!PushNotificationCommand(command)) {
+        expected = handle;
+        pending.queued.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+        return false;
+    }
+    return true;
+}
+
+bool QueueNotificationTextUpdate(uint32_t handle, char *text) {
+    auto &pending = GetPendingUpdate(handle);
+    if (!IsPendingUpdateOwner(handle)) {
+        free(text);
+        return false;
+    }
+    char *superseded = pending.text.exchange(text, std::memory_order_acq_rel);
+    if (superseded != nullptr) {
+        free(superseded);
+        StatisticsAddSupersededUpdate();
+    }
+    if (!IsPendingUpdateOwner(handle)) {
+        // The slot has been reused in the meantime, take the text back unless it has been consumed already.
+        if (pending.text.compare_exchange_strong(text, nullptr, std::memory_order_acq_rel)) {
+            free(text);
+        }
+        return false;
+    }
+    return QueuePendingUpdate(handle);
+}
+
+static bool QueueNotificationColorUpdate(uint32_t handle, std::atomic<uint32_t> &value, uint32_t flag, GX2Color color) {
+    auto &pending = GetPendingUpdate(handle);
+    if (!IsPendingUpdateOwner(handle)) {
+        return false;
+    }
+    value.store(PackColor(color), std::memory_order_relaxed);
+    uint32_t previous = pending.flags.fetch_or(flag, std::memory_order_acq_rel);
+    if (previous & flag) {
+        StatisticsAddSupersededUpdate();
+    }
+    if (!IsPendingUpdateOwner(handle)) {
+        // The slot has been reused in the meantime, withdraw the color if nobody else has set it before.
+        if (!(previous & flag)) {
+            pending.flags.fetch_and(~flag, std::memory_order_acq_rel);
+        }
+        return false;
+    }
+    return QueuePendingUpdate(handle);
+}
+
+bool QueueNotificationTextColorUpdate(uint32_t handle, GX2Color color) {
+    return QueueNotificationColorUpdate(handle, GetPendingUpdate(handle).textColor, PENDING_UPDATE_TEXT_COLOR, color);
+}
+
+bool QueueNotificationBackgroundColorUpdate(uint32_t handle, GX2Color color) {
+    return QueueNotificationColorUpdate(handle, GetPendingUpdate(handle).backgroundColor, PENDING_UPDATE_BACKGROUND_COLOR, color);
+}
+
+static void DiscardPendingUpdate(uint32_t handle) {
+    auto &pending = GetPendingUpdate(handle);
+    free(pending.text.exchange(nullptr, std::memory_order_acq_rel));
+    pending.flags.store(0, std::memory_order_relaxed);
+    pending.queued.store(0, std::memory_order_release);
+}
+
+uint32_t ReserveNotificationHandle() {
+    uint32_t handle = gNotificationHandleTable.reserve();
+    if (handle != 0) {
+        // Leftovers of the previous owner of the slot must never reach the new notification.
+        DiscardPendingUpdate(handle);
+        GetPendingUpdate(handle).handle.store(handle, std::memory_order_release);
+    }
+    return handle;
+}
+
+//!Drops the APPLY command of a handle that is no longer valid
+static void DropPendingUpdate(uint32_t handle) {
+    auto &pending = GetPendingUpdate(handle);
+    if (pending.handle.load(std::memory_order_acquire) == handle) {
+        // Nobody has reserved the slot since, so the values can only belong to the stale handle.
+        DiscardPendingUpdate(handle);
+        return;
+    }
+    // Only clear our own marker, the values belong to the new owner of the slot.
+    uint32_t expected = handle;
+    pending.queued.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+}
+
+static void ApplyPendingUpdate(Notification &notification, uint32_t handle) {
+    auto &pending = GetPendingUpdate(handle);
+    if (pending.handle.load(std::memory_order_acquire) != handle) {
+        DropPendingUpdate(handle);
+        return;
+    }
+    // Clear the marker first, updates that arrive while we are applying queue a new command.
+    uint32_t expected = handle;
+    pending.queued.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+
+    uint32_t flags = pending.flags.exchange(0, std::memory_order_acq_rel);
+    char *text     = pending.text.exchange(nullptr, std::memory_order_acq_rel);
+    if (text != nullptr) {
+        notification.updateText(text);
+        free(text);
+    }
+    if (flags & PENDING_UPDATE_TEXT_COLOR) {
+        notification.updateTextColor(UnpackColor(pending.textColor.load(std::memory_order_relaxed)));
+    }
+    if (flags & PENDING_UPDATE_BACKGROUND_COLOR) {
+        notification.updateBackgroundColor(UnpackColor(pending.backgroundColor.load(std::memory_order_relaxed)));
+    }
+}
+
+void ReleaseNotificationHandle(uint32_t handle) {
+    if (!gNotificationHandleTable.release(handle)) {
+        DEBUG_FUNCTION_LINE_ERR("Failed to release handle %08X", handle);
+        return;
+    }
+    DiscardPendingUpdate(handle);
+}
+
+static void ApplyNotificationCommand(NotificationCommand &command) {
+    if (command.type == NOTIFICATION_COMMAND_ADD) {
+        if (command.handle != 0) {
+            auto *slot = gNotificationHandleTable.get(command.handle);
+            if (slot == nullptr) {
+                DEBUG_FUNCTION_LINE_ERR("Failed to add notification: invalid handle %08X", command.handle);
+                return;
+            }
+            *slot = command.notification;
+        }
+        gOverlayFrame->addNotification(std::move(command.notification));
+        return;
+    }
+
+    // The notification may have been removed since the command was queued.
+    auto *cur = gNotificationHandleTable.get(command.handle);
+    if (cur == nullptr) {
+        if (command.type == NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE) {
+            DropPendingUpdate(command.handle);
+        }
+        return;
+    }
+    if (!*cur) {
+        if (command.type == NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE) {
+            // The handle is still valid but its ADD has not been applied, keep the values for the next update.
+            uint32_t expected = command.handle;
+            GetPendingUpdate(command.handle).queued.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+        }
+        return;
+    }
+    switch (command.type) {
+        case NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE:
+            ApplyPendingUpdate(**cur, command.handle);
+            break;
+        case NOTIFICATION_COMMAND_FINISH:
+            (*cur)->updateStatus(command.status);
+            (*cur)->updateWaitDuration(command.waitDuration);
+            (*cur)->updateShakeDuration(command.shakeDuration);
+            break;
+        default:
+            break;
+    }
+}
+
+void ProcessNotificationCommands() {
+    if (!gOverlayFrame || !gDrawReady || !(gOverlayState.load(std::memory_order_acquire) & OVERLAY_STATE_QUEUE_PENDING)) {
+        return;
+    }
+    gOverlayState.fetch_and(~OVERLAY_STATE_QUEUE_PENDING);
+
+    NotificationCommand command;
+    while (sCommandQueue.pop(command)) {
+        ApplyNotificationCommand(command);
+    }
+}
+
+void CleanUpNotificationCommands() {
+    std::vector<NotificationCommand> commands;
+    std::vector<NotificationCommand> keepQueue;
+    std::vector<uint32_t> keepHandles;
+
+    NotificationCommand command;
+    while (sCommandQueue.pop(command)) {
+        commands.push_back(std::move(command));
+    }
+    gOverlayState.fetch_and(~OVERLAY_STATE_QUEUE_PENDING);
+
+    // OverlayFrame::clearElements hands queued notifications back as ADD commands, behind the updates that have been queued for them.
+    // Move every ADD in front of the other commands (keeping the order otherwise), so updates are applied after their notification again.
+    std::stable_partition(commands.begin(), commands.end(), [](const NotificationCommand &cur) {
+        return cur.type == NOTIFICATION_COMMAND_ADD;
+    });
+    for (auto &cur : commands) {
+        if (cur.type == NOTIFICATION_COMMAND_ADD && cur.handle != 0 && cur.notification->isKeepUntilShown()) {
+            keepHandles.push_back(cur.handle);
+        }
+    }
+    for (auto &cur : commands) {
+        bool keep;
+        if (cur.type == NOTIFICATION_COMMAND_ADD) {
+            keep = cur.notification->isKeepUntilShown();
+        } else {
+            keep = std::find(keepHandles.begin(), keepHandles.end(), cur.handle) != keepHandles.end();
+        }
+        if (keep) {
+            keepQueue.push_back(std::move(cur));
+        } else {
+            FreeNotificationCommand(cur);
+        }
+    }
+
+    gNotificationHandleTable.releaseIf([&keepHandles](uint32_t handle) {
+        if (std::find(keepHandles.begin(), keepHandles.end(), handle) != keepHandles.end()) {
+            return false;
+        }
+        DiscardPendingUpdate(handle);
+        return true;
+    });
+
+    // The queue is empty at this point, so this can't fail.
+    for (auto &cur : keepQueue) {
+        PushNotificationCommand(cur);
+    }
+}
+
+uint32_t GetPendingNotificationCommandCount() {
+    return sCommandQueue.sizeApprox();
+}
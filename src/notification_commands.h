@@ -0,0 +1,59 @@
+#pragma once
+
+#include "gui/Notification.h"
+#include <memory>
+
+typedef enum {
+    NOTIFICATION_COMMAND_ADD,
+    NOTIFICATION_COMMAND_APPLY_PENDING_UPDATE, //!< applies the latest text/colors that have been set via QueueNotification*Update
+    NOTIFICATION_COMMAND_FINISH,
+} NotificationCommandType;
+
+//! Request from an API caller that is applied by the render thread.
+typedef struct NotificationCommand {
+    NotificationCommandType type = NOTIFICATION_COMMAND_ADD;
+    uint32_t handle              = 0;                     //!< 0 for static notifications
+    std::shared_ptr<Notification> notification;           //!< NOTIFICATION_COMMAND_ADD
+    NotificationStatus status = NOTIFICATION_STATUS_INFO; //!< NOTIFICATION_COMMAND_FINISH
+    float waitDuration        = 0.0f;                     //!< NOTIFICATION_COMMAND_FINISH
+    float shakeDuration       = 0.0f;                     //!< NOTIFICATION_COMMAND_FINISH
+} NotificationCommand;
+
+//!Queues a command for the render thread. Lock-free, can be called from any thread.
+//!Takes ownership of the command, even on failure.
+//!\return false if the queue is full
+bool PushNotificationCommand(NotificationCommand &command);
+
+//!Queues count commands in order, stops at the first one that doesn't fit.
+//!Commands that have not been queued are left untouched.
+//!\return number of queued commands
+uint32_t PushNotificationCommands(NotificationCommand *commands, uint32_t count);
+
+//!Reserves the handle of a new dynamic notification and resets its pending updates.
+//!Lock-free, can be called from any thread.
+//!\return 0 if the handle table is full
+uint32_t ReserveNotificationHandle();
+
+//!Replaces the pending text of a dynamic notification, only the latest value is applied at the next frame.
+//!Lock-free, can be called from any thread. Takes ownership of text (allocated via malloc), even on failure.
+//!\return false if the handle is stale or the queue is full. On a full queue the value stays pending and is applied with the next successful update.
+bool QueueNotificationTextUpdate(uint32_t handle, char *text);
+
+//!See QueueNotificationTextUpdate
+bool QueueNotificationTextColorUpdate(uint32_t handle, GX2Color color);
+
+//!See QueueNotificationTextUpdate
+bool QueueNotificationBackgroundColorUpdate(uint32_t handle, GX2Color color);
+
+//!Releases the handle of a dynamic notification and drops its pending updates. Must only be called from the render thread.
+void ReleaseNotificationHandle(uint32_t handle);
+
+//!Applies all queued commands to gOverlayFrame. Must only be called from the render thread.
+void ProcessNotificationCommands();
+
+//!Drops all queued commands and handles, except the ones belonging to a "keep until shown" notification that has not been shown yet.
+//!Must only be called while the render thread isn't running.
+void CleanUpNotificationCommands();
+
+//!\return number of queued commands, only a snapshot
+uint32_t GetPendingNotificationCommandCount();
@@ -1,12 +1,19 @@
 #include "retain_vars.hpp"
 
-GX2SurfaceFormat gTVSurfaceFormat                                     = GX2_SURFACE_FORMAT_UNORM_R8_G8_B8_A8;
-GX2SurfaceFormat gDRCSurfaceFormat                                    = GX2_SURFACE_FORMAT_UNORM_R8_G8_B8_A8;
-GX2ContextState *gContextState                                        = nullptr;
-GX2ContextState *gOriginalContextState                                = nullptr;
-std::mutex gOverlayFrameMutex                                         = {};
-std::vector<std::shared_ptr<Notification>> gOverlayQueueDuringStartup = {};
-OverlayFrame *gOverlayFrame                                           = nullptr;
-SchriftGX2 *gFontSystem                                               = nullptr;
-bool gOverlayInitDone                                                 = false;
-bool gDrawReady                                                       = false;
\ No newline at end of file
+GX2SurfaceFormat gTVSurfaceFormat            = GX2_SURFACE_FORMAT_UNORM_R8_G8_B8_A8;
+GX2SurfaceFormat gDRCSurfaceFormat           = GX2_SURFACE_FORMAT_UNORM_R8_G8_B8_A8;
+GX2ContextState *gContextState               = nullptr;
+GX2ContextState *gOriginalContextState       = nullptr;
+OverlayFrame *gOverlayFrame                  = nullptr;
+SchriftGX2 *gFontSystem                      = nullptr;
+bool gOverlayInitDone                        = false;
+bool gDrawReady                              = false;
+OSEvent gOverlayReadyEvent                   = {};
+std::atomic<uint32_t> gOverlayState          = OVERLAY_STATE_IDLE;
+std::atomic<uint32_t> gOverlayOverflowPolicy = OVERLAY_OVERFLOW_POLICY_QUEUE;
+GPUTimer gTVOverlayGPUTimer                  = {};
+GPUTimer gDRCOverlayGPUTimer                 = {};
+
+static_assert(OVERLAY_STACK_COUNT == 6, "Initialize the limit of every stack");
+std::atomic<uint32_t> gOverlayMaxVisible[OVERLAY_STACK_COUNT] = {OVERLAY_DEFAULT_MAX_VISIBLE, OVERLAY_DEFAULT_MAX_VISIBLE, OVERLAY_DEFAULT_MAX_VISIBLE,
+                                                                 OVERLAY_DEFAULT_MAX_VISIBLE, OVERLAY_DEFAULT_MAX_VISIBLE, OVERLAY_DEFAULT_MAX_VISIBLE};
\ No newline at end of file
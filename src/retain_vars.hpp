@@ -1,15 +1,28 @@
 #pragma once
 #include "gui/OverlayFrame.h"
 #include "gui/SchriftGX2.h"
+#include "utils/GPUTimer.h"
+#include <atomic>
+#include <coreinit/event.h>
 #include <gx2/context.h>
 
+typedef enum {
+    OVERLAY_STATE_IDLE          = 0,
+    OVERLAY_STATE_ACTIVE        = 1 << 0, //!< gOverlayFrame holds at least one notification
+    OVERLAY_STATE_QUEUE_PENDING = 1 << 1, //!< API requests are waiting to be processed by the render thread
+} OverlayStateFlags;
+
 extern GX2SurfaceFormat gTVSurfaceFormat;
 extern GX2SurfaceFormat gDRCSurfaceFormat;
 extern GX2ContextState *gContextState;
 extern GX2ContextState *gOriginalContextState;
-extern std::mutex gOverlayFrameMutex;
-extern std::vector<std::shared_ptr<Notification>> gOverlayQueueDuringStartup;
 extern OverlayFrame *gOverlayFrame;
 extern SchriftGX2 *gFontSystem;
 extern bool gOverlayInitDone;
-extern bool gDrawReady;
\ No newline at end of file
+extern bool gDrawReady;
+extern OSEvent gOverlayReadyEvent; //!< Manual reset event, signaled once gDrawReady is set
+extern std::atomic<uint32_t> gOverlayState;
+extern std::atomic<uint32_t> gOverlayMaxVisible[OVERLAY_STACK_COUNT]; //!< Per OverlayStackId
+extern std::atomic<uint32_t> gOverlayOverflowPolicy;                  //!< OverlayOverflowPolicy
+extern GPUTimer gTVOverlayGPUTimer;
+extern GPUTimer gDRCOverlayGPUTimer;
\ No newline at end of file
@@ -15,7 +15,15 @@ extern "C" {
 #include <gx2/surface.h>
 #include <gx2/texture.h>
 
-#define GX2_AA_BUFFER_CLEAR_VALUE 0xCC
+#define GX2_AA_BUFFER_CLEAR_VALUE  0xCC
+
+//! Clock of the timestamps written by GX2Sample*GPUCycle
+#define GX2_GPU_TIMESTAMP_CLOCK_HZ 27000000
+
+//! Writes the GPU timestamp when the command reaches the top of the pipeline
+void GX2SampleTopGPUCycle(uint64_t *cycle);
+//! Writes the GPU timestamp once all previous commands have finished
+void GX2SampleBottomGPUCycle(uint64_t *cycle);
 
 #define GX2_COMP_SEL_NONE         0x04040405
 #define GX2_COMP_SEL_X001         0x00040405
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+//! Fixed number of equally sized blocks in caller provided memory.
+//! The allocation state is tracked in an atomic bitmap, so allocate() and free() are lock-free and can be called from any thread.
+template<uint32_t BlockCount>
+class FixedBlockPool {
+    static_assert(BlockCount > 0 && BlockCount % 32 == 0, "BlockCount has to be a multiple of 32");
+
+public:
+    //!\param storage has to hold BlockCount * blockSize bytes and stay valid until destroy() is called
+    void init(void *storage, uint32_t blockSize) {
+        this->blockSize = blockSize;
+        this->storage   = (uint8_t *) storage;
+    }
+
+    //!\return pointer to the released storage, so it can be freed by the caller
+    void *destroy() {
+        void *res = storage;
+        storage   = nullptr;
+        return res;
+    }
+
+    //!\return block of getBlockSize() bytes, nullptr if the pool is exhausted or not initialized
+    void *allocate() {
+        if (storage == nullptr) {
+            return nullptr;
+        }
+        for (uint32_t i = 0; i < BlockCount / 32; i++) {
+            uint32_t bits = used[i].load(std::memory_order_relaxed);
+            while (bits != 0xFFFFFFFF) {
+                uint32_t bit = __builtin_ctz(~bits);
+                if (used[i].compare_exchange_weak(bits, bits | (1u << bit), std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return storage + (i * 32 + bit) * blockSize;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] bool owns(const void *ptr) const {
+        return storage != nullptr && ptr >= storage && ptr < storage + BlockCount * blockSize;
+    }
+
+    void free(void *ptr) {
+        uint32_t index = ((uint8_t *) ptr - storage) / blockSize;
+        used[index / 32].fetch_and(~(1u << (index % 32)), std::memory_order_release);
+    }
+
+    [[nodiscard]] uint32_t getBlockSize() const {
+        return blockSize;
+    }
+
+private:
+    uint8_t *storage   = nullptr;
+    uint32_t blockSize = 0;
+    std::atomic<uint32_t> used[BlockCount / 32] = {};
+};
+
+//! Allocator that takes blocks from Pool and falls back to the heap if the pool is exhausted or the request doesn't fit into one block
+//! Like std::allocator it throws std::bad_alloc if the heap is exhausted as well, see make_shared_pooled
+template<typename T, auto &Pool>
+class FixedBlockPoolAllocator {
+public:
+    using value_type = T;
+
+    FixedBlockPoolAllocator() = default;
+
+    template<typename U>
+    FixedBlockPoolAllocator(const FixedBlockPoolAllocator<U, Pool> &) {
+    }
+
+    template<typename U>
+    struct rebind {
+        using other = FixedBlockPoolAllocator<U, Pool>;
+    };
+
+    T *allocate(size_t n) {
+        if (n * sizeof(T) <= Pool.getBlockSize()) {
+            void *res = Pool.allocate();
+            if (res) {
+                return (T *) res;
+            }
+        }
+        return (T *) ::operator new(n * sizeof(T));
+    }
+
+    void deallocate(T *ptr, size_t) {
+        if (Pool.owns(ptr)) {
+            Pool.free(ptr);
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const FixedBlockPoolAllocator<U, Pool> &) const {
+        return true;
+    }
+};
@@ -0,0 +1,90 @@
+#include "GPUTimer.h"
+#include "shaders/gx2_ext.h"
+#include <coreinit/cache.h>
+#include <cstring>
+#include <memory/mappedmemory.h>
+
+bool GPUTimer::init() {
+    if (timestamps != nullptr) {
+        return true;
+    }
+    // The GPU writes into this memory, it has to be accessible by GX2
+    timestamps = (uint64_t *) MEMAllocFromMappedMemoryForGX2Ex(SLOT_COUNT * 2 * sizeof(uint64_t), 0x40);
+    if (timestamps == nullptr) {
+        return false;
+    }
+    memset(timestamps, 0, SLOT_COUNT * 2 * sizeof(uint64_t));
+    DCFlushRange(timestamps, SLOT_COUNT * 2 * sizeof(uint64_t));
+    return true;
+}
+
+void GPUTimer::destroy() {
+    if (timestamps) {
+        MEMFreeToMappedMemory(timestamps);
+        timestamps = nullptr;
+    }
+}
+
+void GPUTimer::begin() {
+    if (timestamps == nullptr) {
+        return;
+    }
+    if (slotPending[currentSlot]) {
+        collect(currentSlot);
+    }
+    uint64_t *slotTimestamps = &timestamps[currentSlot * 2];
+    slotTimestamps[0]        = 0;
+    slotTimestamps[1]        = 0;
+    DCFlushRange(slotTimestamps, 2 * sizeof(uint64_t));
+
+    // Use the bottom of the pipe for both samples, the top of the pipe would include the game's commands still in flight.
+    GX2SampleBottomGPUCycle(&slotTimestamps[0]);
+    measuring = true;
+}
+
+void GPUTimer::end() {
+    if (!measuring) {
+        return;
+    }
+    GX2SampleBottomGPUCycle(&timestamps[currentSlot * 2 + 1]);
+    slotPending[currentSlot] = true;
+    currentSlot              = (currentSlot + 1) % SLOT_COUNT;
+    measuring                = false;
+}
+
+void GPUTimer::collect(uint32_t slot) {
+    slotPending[slot]        = false;
+    uint64_t *slotTimestamps = &timestamps[slot * 2];
+    DCInvalidateRange(slotTimestamps, 2 * sizeof(uint64_t));
+    uint64_t start = slotTimestamps[0];
+    uint64_t end   = slotTimestamps[1];
+    if (start == 0 || end < start) {
+        // GPU didn't get to it yet, drop the sample
+        return;
+    }
+    auto durationInNs = (uint32_t) (((end - start) * 1000000000ull) / GX2_GPU_TIMESTAMP_CLOCK_HZ);
+
+    // Never wait for a reader on the render thread
+    std::unique_lock<std::mutex> lock(ringMutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        ring.push(durationInNs);
+    }
+}
+
+void GPUTimer::reset() {
+    // Timestamps written during the previous application must not end up in the new samples
+    for (auto &pending : slotPending) {
+        pending = false;
+    }
+    currentSlot = 0;
+    measuring   = false;
+
+    std::lock_guard<std::mutex> lock(ringMutex);
+    ring.clear();
+}
+
+uint32_t GPUTimer::getStats(uint32_t &outMin, uint32_t &outAvg, uint32_t &outP99, uint32_t &outLast) {
+    std::lock_guard<std::mutex> lock(ringMutex);
+    ring.summarize(outMin, outAvg, outP99, outLast);
+    return ring.size();
+}
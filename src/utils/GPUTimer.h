@@ -0,0 +1,41 @@
+#pragma once
+
+#include "SampleRing.h"
+#include <cstdint>
+#include <mutex>
+
+//! Measures the GPU time of a command range via GPU timestamps.
+//! The results are read back a few frames later, so measuring never stalls on the GPU.
+class GPUTimer {
+public:
+    bool init();
+
+    void destroy();
+
+    //!Has to be called from the render thread, right before the commands that should be measured
+    void begin();
+
+    //!Has to be called from the render thread, right after the commands that should be measured
+    void end();
+
+    //!Drops all collected samples and the timestamps still in flight, must not be called while the render thread is measuring
+    void reset();
+
+    //!Durations in nanoseconds over the last SAMPLE_COUNT measurements
+    uint32_t getStats(uint32_t &outMin, uint32_t &outAvg, uint32_t &outP99, uint32_t &outLast);
+
+    static constexpr uint32_t SAMPLE_COUNT = 128;
+
+private:
+    void collect(uint32_t slot);
+
+    //! Number of frames a timestamp pair may stay in flight
+    static constexpr uint32_t SLOT_COUNT = 4;
+
+    uint64_t *timestamps          = nullptr; //!< [SLOT_COUNT][begin, end], written by the GPU
+    bool slotPending[SLOT_COUNT]  = {};
+    uint32_t currentSlot          = 0;
+    bool measuring                = false;
+    SampleRing<SAMPLE_COUNT> ring = {};
+    std::mutex ringMutex;
+};
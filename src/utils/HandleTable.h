@@ -0,0 +1,94 @@
+#pragma once
+
+#include "utils/LockFreeRing.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//! Fixed size table that maps handles to values in O(1).
+//! A handle consists of the slot index (lower 16 bit) and the generation of the slot (upper 16 bit).
+//! The generation is bumped whenever a slot is released, so stale handles are rejected even if the slot is reused.
+//! 0 is never a valid handle.
+//!
+//! reserve() and isValid() are lock-free and can be called from any thread.
+//! The value of an entry must only be accessed by the thread that currently owns the entry, and only the owner may release it.
+template<typename T, uint32_t N>
+class HandleTable {
+    static_assert(N <= 0x10000, "The slot index has to fit into 16 bit");
+
+public:
+    HandleTable() {
+        for (uint32_t i = 0; i < N; i++) {
+            freeSlots.push(i);
+        }
+    }
+
+    //!\return handle of the new entry, 0 if the table is full
+    uint32_t reserve() {
+        uint32_t index;
+        if (!freeSlots.pop(index)) {
+            return 0;
+        }
+        uint32_t generation = slots[index].state.load(std::memory_order_relaxed) >> 16;
+        slots[index].state.store((generation << 16) | SLOT_USED, std::memory_order_release);
+        return (generation << 16) | index;
+    }
+
+    [[nodiscard]] bool isValid(uint32_t handle) const {
+        uint32_t index = handle & 0xFFFF;
+        if (handle == 0 || index >= N) {
+            return false;
+        }
+        return slots[index].state.load(std::memory_order_acquire) == ((handle & 0xFFFF0000) | SLOT_USED);
+    }
+
+    //!\return pointer to the value, nullptr if the handle is invalid or stale
+    T *get(uint32_t handle) {
+        if (!isValid(handle)) {
+            return nullptr;
+        }
+        return &slots[handle & 0xFFFF].value;
+    }
+
+    bool release(uint32_t handle) {
+        if (!isValid(handle)) {
+            return false;
+        }
+        uint32_t index = handle & 0xFFFF;
+        auto &slot     = slots[index];
+        slot.value     = {};
+        // 0 is reserved so a handle can never be 0
+        uint32_t generation = ((handle >> 16) + 1) & 0xFFFF;
+        if (generation == 0) {
+            generation = 1;
+        }
+        slot.state.store(generation << 16, std::memory_order_release);
+        freeSlots.push(index);
+        return true;
+    }
+
+    //!Releases all entries for which pred(handle) returns true
+    template<class Predicate>
+    void releaseIf(Predicate pred) {
+        for (uint32_t i = 0; i < N; i++) {
+            uint32_t state = slots[i].state.load(std::memory_order_acquire);
+            if (state & SLOT_USED) {
+                uint32_t handle = (state & 0xFFFF0000) | i;
+                if (pred(handle)) {
+                    release(handle);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t SLOT_USED = 1;
+
+    typedef struct Slot {
+        std::atomic<uint32_t> state{1 << 16}; //!< generation (upper 16 bit) | SLOT_USED
+        T value = {};
+    } Slot;
+
+    std::array<Slot, N> slots;
+    LockFreeRing<uint32_t, N> freeSlots;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//! Bounded lock-free FIFO queue (Dmitry Vyukov's bounded MPMC queue).
+//! push and pop never block, they fail if the queue is full or empty.
+template<typename T, uint32_t N>
+class LockFreeRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N has to be a power of two");
+
+public:
+    LockFreeRing() {
+        for (uint32_t i = 0; i < N; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(T &&value) {
+        Cell *cell;
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            cell         = &cells[pos & (N - 1)];
+            uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff    = (int32_t) (seq - pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // full
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &value) {
+        T copy = value;
+        return push(std::move(copy));
+    }
+
+    bool pop(T &out) {
+        Cell *cell;
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            cell         = &cells[pos & (N - 1)];
+            uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff    = (int32_t) (seq - (pos + 1));
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // empty (or the next element is still being written)
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    //!\return number of queued elements, only a snapshot if other threads are using the queue
+    [[nodiscard]] uint32_t sizeApprox() const {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+    }
+
+private:
+    typedef struct Cell {
+        std::atomic<uint32_t> sequence;
+        T value;
+    } Cell;
+
+    std::array<Cell, N> cells;
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+};
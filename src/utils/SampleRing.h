@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+//! Keeps the last N samples and calculates min/avg/p99 over them on request
+template<uint32_t N>
+class SampleRing {
+public:
+    void push(uint32_t value) {
+        samples[next] = value;
+        next          = (next + 1) % N;
+        if (count < N) {
+            count++;
+        }
+        last = value;
+    }
+
+    void clear() {
+        next  = 0;
+        count = 0;
+        last  = 0;
+    }
+
+    [[nodiscard]] uint32_t size() const {
+        return count;
+    }
+
+    void summarize(uint32_t &outMin, uint32_t &outAvg, uint32_t &outP99, uint32_t &outLast) const {
+        outMin  = 0;
+        outAvg  = 0;
+        outP99  = 0;
+        outLast = last;
+        if (count == 0) {
+            return;
+        }
+        std::array<uint32_t, N> sorted;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            sorted[i] = samples[i];
+            sum += samples[i];
+        }
+        uint32_t p99Index = (count * 99 + 99) / 100 - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + p99Index, sorted.begin() + count);
+        outP99 = sorted[p99Index];
+        outMin = *std::min_element(sorted.begin(), sorted.begin() + count);
+        outAvg = (uint32_t) (sum / count);
+    }
+
+private:
+    std::array<uint32_t, N> samples{};
+    uint32_t next  = 0;
+    uint32_t count = 0;
+    uint32_t last  = 0;
+};
@@ -0,0 +1,87 @@
+#include "Statistics.h"
+
+static TimingHistogram sHistograms[STATISTIC_TIMER_COUNT];
+static std::atomic<uint32_t> sGlyphCacheHits;
+static std::atomic<uint32_t> sGlyphCacheMisses;
+static std::atomic<uint32_t> sLiveNotifications;
+static std::atomic<uint32_t> sSupersededUpdates;
+static std::atomic<uint32_t> sDroppedNotifications;
+
+void StatisticsAddTiming(StatisticTimer timer, OSTick durationInTicks) {
+    if (timer < 0 || timer >= STATISTIC_TIMER_COUNT) {
+        return;
+    }
+    auto durationInUs = (uint32_t) OSTicksToMicroseconds((uint64_t) (uint32_t) durationInTicks);
+    uint32_t bucket   = 0;
+    if (durationInUs > 0) {
+        bucket = 32 - __builtin_clz(durationInUs);
+        if (bucket >= STATISTIC_HISTOGRAM_BUCKETS) {
+            bucket = STATISTIC_HISTOGRAM_BUCKETS - 1;
+        }
+    }
+    auto &histogram = sHistograms[timer];
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    uint32_t curMax = histogram.maxInUs.load(std::memory_order_relaxed);
+    while (durationInUs > curMax && !histogram.maxInUs.compare_exchange_weak(curMax, durationInUs, std::memory_order_relaxed)) {
+    }
+}
+
+void StatisticsAddGlyphCacheLookup(bool hit) {
+    if (hit) {
+        sGlyphCacheHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        sGlyphCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StatisticsNotificationCreated() {
+    sLiveNotifications.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatisticsNotificationDestroyed() {
+    sLiveNotifications.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void StatisticsAddSupersededUpdate() {
+    sSupersededUpdates.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatisticsAddDroppedNotification() {
+    sDroppedNotifications.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatisticsReset() {
+    for (auto &histogram : sHistograms) {
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.maxInUs.store(0, std::memory_order_relaxed);
+        for (auto &bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    sGlyphCacheHits.store(0, std::memory_order_relaxed);
+    sGlyphCacheMisses.store(0, std::memory_order_relaxed);
+    sSupersededUpdates.store(0, std::memory_order_relaxed);
+    sDroppedNotifications.store(0, std::memory_order_relaxed);
+}
+
+const TimingHistogram &StatisticsGetHistogram(StatisticTimer timer) {
+    return sHistograms[timer];
+}
+
+void StatisticsGetGlyphCacheLookups(uint32_t &outHits, uint32_t &outMisses) {
+    outHits   = sGlyphCacheHits.load(std::memory_order_relaxed);
+    outMisses = sGlyphCacheMisses.load(std::memory_order_relaxed);
+}
+
+uint32_t StatisticsGetLiveNotificationCount() {
+    return sLiveNotifications.load(std::memory_order_relaxed);
+}
+
+uint32_t StatisticsGetSupersededUpdateCount() {
+    return sSupersededUpdates.load(std::memory_order_relaxed);
+}
+
+uint32_t StatisticsGetDroppedNotificationCount() {
+    return sDroppedNotifications.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <coreinit/time.h>
+#include <cstdint>
+
+typedef enum {
+    STATISTIC_TIMER_FRAME_PROCESS, //!< OverlayFrame::process + updateEffects in the GX2SwapScanBuffers hook
+    STATISTIC_TIMER_OVERLAY_DRAW,  //!< drawIntoColorBuffer
+    STATISTIC_TIMER_CACHE_GLYPH,   //!< SchriftGX2::cacheGlyphData
+    STATISTIC_TIMER_API_CALL,      //!< exported NM* functions
+    STATISTIC_TIMER_COUNT,
+} StatisticTimer;
+
+//! Bucket 0 counts durations < 1us, bucket n counts [2^(n-1), 2^n) us, the last bucket is open-ended
+#define STATISTIC_HISTOGRAM_BUCKETS 16
+
+typedef struct TimingHistogram {
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> maxInUs;
+    std::atomic<uint32_t> buckets[STATISTIC_HISTOGRAM_BUCKETS];
+} TimingHistogram;
+
+void StatisticsAddTiming(StatisticTimer timer, OSTick durationInTicks);
+
+void StatisticsAddGlyphCacheLookup(bool hit);
+
+void StatisticsNotificationCreated();
+
+void StatisticsNotificationDestroyed();
+
+//! A pending update of a dynamic notification was replaced before the render thread applied it
+void StatisticsAddSupersededUpdate();
+
+//! A notification was removed by the overflow policy of the overlay
+void StatisticsAddDroppedNotification();
+
+void StatisticsReset();
+
+const TimingHistogram &StatisticsGetHistogram(StatisticTimer timer);
+
+void StatisticsGetGlyphCacheLookups(uint32_t &outHits, uint32_t &outMisses);
+
+uint32_t StatisticsGetLiveNotificationCount();
+
+uint32_t StatisticsGetSupersededUpdateCount();
+
+uint32_t StatisticsGetDroppedNotificationCount();
+
+//! Adds the lifetime of this object to the histogram of the given timer
+class ScopedStatisticTimer {
+public:
+    explicit ScopedStatisticTimer(StatisticTimer timer) : timer(timer), start(OSGetSystemTick()) {
+    }
+
+    ~ScopedStatisticTimer() {
+        StatisticsAddTiming(timer, OSGetSystemTick() - start);
+    }
+
+    ScopedStatisticTimer(const ScopedStatisticTimer &)            = delete;
+    ScopedStatisticTimer &operator=(const ScopedStatisticTimer &) = delete;
+
+private:
+    StatisticTimer timer;
+    OSTick start;
+};
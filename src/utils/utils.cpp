@@ -1,5 +1,7 @@
 #include "utils.h"
+#include "shaders/ColorShader.h"
 #include "utils/logger.h"
+#include <memory/mappedmemory.h>
 #include <string.h>
 #include <whb/log.h>
 
@@ -74,5 +76,33 @@ uint8_t SRGBComponentToRGBTable[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0
                                      0xBE, 0xC0, 0xC1, 0xC3, 0xC5, 0xC7, 0xC9, 0xCB, 0xCD, 0xCF, 0xD1, 0xD3, 0xD5, 0xD7, 0xDA, 0xDC,
                                      0xDE, 0xE0, 0xE2, 0xE4, 0xE6, 0xE8, 0xEB, 0xED, 0xEF, 0xF1, 0xF3, 0xF5, 0xF8, 0xFA, 0xFC, 0xFF};
 
-std::mutex gNotificationListMutex;
-std::forward_list<std::shared_ptr<Notification>> gNotificationList;
\ No newline at end of file
+HandleTable<std::shared_ptr<Notification>, NOTIFICATION_HANDLE_TABLE_SIZE> gNotificationHandleTable;
+
+// Leaves room for the shared_ptr control block that is allocated together with the Notification.
+#define NOTIFICATION_POOL_BLOCK_SIZE ROUNDUP(sizeof(Notification) + 32, 32)
+#define COLOR_VERTEX_POOL_BLOCK_SIZE ROUNDUP(ColorShader::cuColorVtxsSize, GX2_VERTEX_BUFFER_ALIGNMENT)
+
+alignas(32) static uint8_t sNotificationPoolStorage[NOTIFICATION_POOL_BLOCK_SIZE * NOTIFICATION_POOL_SIZE];
+
+FixedBlockPool<NOTIFICATION_POOL_SIZE> gNotificationPool;
+FixedBlockPool<COLOR_VERTEX_POOL_BLOCK_COUNT> gColorVertexPool;
+
+bool InitAllocationPools() {
+    gNotificationPool.init(sNotificationPoolStorage, NOTIFICATION_POOL_BLOCK_SIZE);
+
+    // One allocation from the mapped memory heap for all vertex buffers
+    auto *colorVertexStorage = MEMAllocFromMappedMemoryForGX2Ex(COLOR_VERTEX_POOL_BLOCK_SIZE * COLOR_VERTEX_POOL_BLOCK_COUNT, GX2_VERTEX_BUFFER_ALIGNMENT);
+    if (!colorVertexStorage) {
+        return false;
+    }
+    gColorVertexPool.init(colorVertexStorage, COLOR_VERTEX_POOL_BLOCK_SIZE);
+    return true;
+}
+
+void DestroyAllocationPools() {
+    // gNotificationPool lives in static storage and doesn't need to be freed.
+    auto *colorVertexStorage = gColorVertexPool.destroy();
+    if (colorVertexStorage) {
+        MEMFreeToMappedMemory(colorVertexStorage);
+    }
+}
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "gui/Notification.h"
-#include <forward_list>
+#include "utils/FixedBlockPool.h"
+#include "utils/HandleTable.h"
 #include <memory>
 #include <mutex>
+#include <new>
 #include <vector>
 
 template<class T, class... Args>
@@ -16,20 +18,6 @@ std::shared_ptr<T> make_shared_nothrow(Args &&...args) noexcept(noexcept(T(std::
     return std::shared_ptr<T>(new (std::nothrow) T(std::forward<Args>(args)...));
 }
 
-template<typename T, class Allocator, class Predicate>
-bool remove_locked_first_if(std::mutex &mutex, std::forward_list<T, Allocator> &list, Predicate pred) {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto oit = list.before_begin(), it = std::next(oit);
-    while (it != list.end()) {
-        if (pred(*it)) {
-            list.erase_after(oit);
-            return true;
-        }
-        oit = it++;
-    }
-    return false;
-}
-
 // those work only in powers of 2
 #define ROUNDDOWN(val, align) ((val) & ~(align - 1))
 #define ROUNDUP(val, align)   ROUNDDOWN(((val) + (align - 1)), align)
@@ -45,5 +33,34 @@ inline uint8_t RGBComponentToSRGB(uint8_t ci) {
     return RGBComponentToSRGBTable[ci];
 }
 
-extern std::mutex gNotificationListMutex;
-extern std::forward_list<std::shared_ptr<Notification>> gNotificationList;
\ No newline at end of file
+#define NOTIFICATION_HANDLE_TABLE_SIZE 1024
+
+//! Entries are reserved by the API callers, afterwards they are owned by the render thread.
+extern HandleTable<std::shared_ptr<Notification>, NOTIFICATION_HANDLE_TABLE_SIZE> gNotificationHandleTable;
+
+#define NOTIFICATION_POOL_SIZE 64
+
+//! Notifications including their shared_ptr control block, see make_shared_pooled
+extern FixedBlockPool<NOTIFICATION_POOL_SIZE> gNotificationPool;
+//! Backgrounds of all pooled notifications and the "+N more" summaries of the stacks, each image takes two blocks.
+//! Rounded up to the granularity of FixedBlockPool.
+#define COLOR_VERTEX_POOL_BLOCK_COUNT ROUNDUP(NOTIFICATION_POOL_SIZE * 2 + OVERLAY_STACK_COUNT * 2, 32)
+
+//! GPU visible color vertex buffers of GuiImage
+extern FixedBlockPool<COLOR_VERTEX_POOL_BLOCK_COUNT> gColorVertexPool;
+
+bool InitAllocationPools();
+
+void DestroyAllocationPools();
+
+//!Allocates the object and its control block with a single allocation from Pool, falls back to the heap if the pool is exhausted
+//!\return nullptr if the heap is exhausted as well
+template<class T, auto &Pool, class... Args>
+std::shared_ptr<T> make_shared_pooled(Args &&...args) {
+    try {
+        return std::allocate_shared<T>(FixedBlockPoolAllocator<T, Pool>(), std::forward<Args>(args)...);
+    } catch (const std::bad_alloc &) {
+        // The allocator has to throw, callers expect the nullptr of the former new (std::nothrow).
+        return nullptr;
+    }
+}
\ No newline at end of file